@@ -120,7 +120,7 @@ float mouse_smooth_factor(0.0), tree_depth_scale(1.0), head_bob_amount(0.0);
 float light_int_scale[NUM_LIGHTING_TYPES] = {1.0, 1.0, 1.0, 1.0, 1.0}, first_ray_weight[NUM_LIGHTING_TYPES] = {1.0, 1.0, 1.0, 1.0, 1.0};
 double camera_zh(0.0);
 point mesh_origin(all_zeros), camera_pos(all_zeros), cube_map_center(all_zeros);
-string user_text, cobjs_out_fn, sphere_materials_fn, hmap_out_fn, skybox_cube_map_name, coll_damage_name, assimp_alpha_exclude_str;
+string user_text, cobjs_out_fn, sphere_materials_fn, hmap_out_fn, hmap_cache_fn, skybox_cube_map_name, coll_damage_name, assimp_alpha_exclude_str;
 colorRGB ambient_lighting_scale(1,1,1), mesh_color_scale(1,1,1);
 colorRGBA flower_color(ALPHA0);
 set<unsigned char> keys, keyset;
@@ -150,7 +150,7 @@ extern point hmv_pos, camera_last_pos;
 extern colorRGBA sunlight_color;
 extern int coll_id[];
 extern float tree_lod_scales[4];
-extern string read_hmap_modmap_fn, write_hmap_modmap_fn, read_voxel_brush_fn, write_voxel_brush_fn, font_texture_atlas_fn;
+extern string read_hmap_modmap_fn, write_hmap_modmap_fn, read_voxel_brush_fn, write_voxel_brush_fn, font_texture_atlas_fn, waypoint_cache_fn;
 extern vector<bbox> team_starts;
 extern player_state *sstates;
 extern pt_line_drawer obj_pld;
@@ -2030,6 +2030,8 @@ int load_config(string const &config_file) {
 	kwms.add("font_texture_atlas_fn", font_texture_atlas_fn);
 	kwms.add("sphere_materials_fn", sphere_materials_fn);
 	kwms.add("write_heightmap_png", hmap_out_fn);
+	kwms.add("heightmap_cache_filename", hmap_cache_fn);
+	kwms.add("waypoint_cache_filename", waypoint_cache_fn);
 	kwms.add("skybox_cube_map", skybox_cube_map_name);
 	kwms.add("assimp_alpha_exclude_str", assimp_alpha_exclude_str);
 
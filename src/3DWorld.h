@@ -1436,6 +1436,7 @@ class  shape3d;
 struct color_tid_vol;
 class  vert_coll_detector;
 struct cobj_query_callback;
+struct coll_line_query_t;
 struct user_waypt_t;
 class  voxel_model;
 
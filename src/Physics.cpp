@@ -704,6 +704,9 @@ float dwobject::get_true_radius() const {
 	return radius;
 }
 
+phys_step_t get_frame_phys_step() {return phys_step_t(TIMESTEP, tstep);}
+
+
 float dwobject::get_true_density() const {
 	return ((type == MAT_SPHERE) ? get_mat_sphere_density(*this) : object_types[type].density);
 }
@@ -716,7 +719,7 @@ float dwobject::get_true_mass() const {
 
 
 // 0 = out of range/expired, 1 = airborne, 2 = collision, 3 = moving on ground, 4 = motionless
-void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj_index) { // returns collision status
+void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj_index, phys_step_t const &step) { // returns collision status
 
 	assert(!disabled());
 	if (temperature <= ABSOLUTE_ZERO) return;
@@ -742,9 +745,9 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 	if (disable_motionless_objects && status == 4 && ground_mode) {
 		if ((flags & IS_ON_ICE) || (!(flags & (FLOATING | STATIC_COBJ_COLL)) && object_still_stopped(obj_index))) {
 			point const old_pos(pos);
-			check_vert_collision(obj_index, 1, iter); // needed for gameplay (already tested in object_still_stopped()?)
+			check_vert_collision(obj_index, 1, iter, NULL, all_zeros, 0, 0, -1, 0, &step); // needed for gameplay (already tested in object_still_stopped()?)
 			pos = old_pos;
-			if (disabled() || check_water_collision(velocity.z)) return;
+			if (disabled() || check_water_collision(velocity.z, step)) return;
 			if (pos.z < zmin || !is_over_mesh(pos)) status = 0;
 			flags &= ~Z_STOPPED;
 			return;
@@ -804,7 +807,7 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 				float const grav_well(min(1.0f, 0.1f*v_flow.mag()));
 
 				if (-velocity.z < otype.terminal_vel) {
-					velocity.z -= (1.0 - grav_well)*base_gravity*gscale*GRAVITY*tstep*otype.gravity;
+					velocity.z -= (1.0 - grav_well)*base_gravity*gscale*GRAVITY*step.tstep*otype.gravity;
 					velocity.z  = grav_well*velocity.z - (1.0f - grav_well)*min(-velocity.z, otype.terminal_vel);
 				}
 				if (fabs(air_factor*vtot.z) > fabs(velocity.z) || ((vtot.z < 0.0f) != (velocity.z < 0.0f))) {
@@ -813,7 +816,7 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 			}
 			else {
 				if (-velocity.z < otype.terminal_vel) {
-					velocity.z -= base_gravity*gscale*GRAVITY*tstep*otype.gravity;
+					velocity.z -= base_gravity*gscale*GRAVITY*step.tstep*otype.gravity;
 					velocity.z  = -min(-velocity.z, otype.terminal_vel);
 				}
 				if (fabs(air_factor*local_wind.z) > fabs(velocity.z) || ((local_wind.z < 0) != (velocity.z < 0))) {
@@ -830,12 +833,12 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 					bool const stopped(friction >= 2.0*STICK_THRESHOLD || fabs(velocity[d]) <= friction);
 					velocity[d] = (stopped ? 0.0 : max(0.0f, (velocity[d] + ((velocity[d] > 0.0) ? -friction : friction))));
 				}
-				pos[d] += tstep*velocity[d]; // move object
+				pos[d] += step.tstep*velocity[d]; // move object
 			}
 			if (flags & FLOATING) {float_downstream(pos, radius);}
 		}
-		assert(isfinite(tstep));
-		pos.z += tstep*velocity.z;
+		assert(isfinite(step.tstep));
+		pos.z += step.tstep*velocity.z;
 		verify_data();
 
 		// check collisions
@@ -850,11 +853,11 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 			if ((ground_mode && pos.z < zmin) || (flags & Z_STOPPED)) {status = 0;} // out of simulation region and underwater
 			return;
 		}
-		int const wcoll(check_water_collision(vz_old));
+		int const wcoll(check_water_collision(vz_old, step));
 		vector3d cnorm;
 		bool const last_stat_coll((flags & STATIC_COBJ_COLL) != 0);
 		old_pos = pos;
-		int coll(check_vert_collision(obj_index, 1, iter, &cnorm));
+		int coll(check_vert_collision(obj_index, 1, iter, &cnorm, all_zeros, 0, 0, -1, 0, &step));
 		if (disabled()) return;
 
 		if (!ground_mode) { // tiled terrain
@@ -909,15 +912,15 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 		}
 		if (otype.flags & COLL_DESTROYS) {assert(type != SMILEY); status = 0; return;}
 		if (flags & STATIC_COBJ_COLL) return; // stuck on vertical collision surface
-		if (check_water_collision(velocity.z) && (frozen || get_true_density() < WATER_DENSITY)) return;
+		if (check_water_collision(velocity.z, step) && (frozen || get_true_density() < WATER_DENSITY)) return;
 		if (flags & IS_CUBE_FLAG) return;
 		if (is_flat() || (otype.flags & OBJ_IS_CYLIN)) {set_orient_for_coll(NULL);}
-		int const val(surface_advance()); // move along ground
+		int const val(surface_advance(step)); // move along ground
 
 		if (val == 2) { // moved, recalculate velocity from position change
 			status = 3;
-			if (is_large) {check_vert_collision(obj_index, 1, iter);} // adds instability though
-			assert(tstep > 0.0);
+			if (is_large) {check_vert_collision(obj_index, 1, iter, NULL, all_zeros, 0, 0, -1, 0, &step);} // adds instability though
+			assert(step.tstep > 0.0);
 			if (is_large && velocity != zero_vector) {modify_grass_at(pos, radius, 1);} // crush grass
 		}
 		else if (val == 1) { // stopped
@@ -930,7 +933,7 @@ void dwobject::advance_object(bool disable_motionless_objects, int iter, int obj
 				}
 			}
 			if (status != 4) {
-				check_vert_collision(obj_index, 0, iter); // one last time before the object is "stopped"???
+				check_vert_collision(obj_index, 0, iter, NULL, all_zeros, 0, 0, -1, 0, &step); // one last time before the object is "stopped"???
 				velocity = zero_vector;
 				if (!disabled()) {status = 4;}
 			}
@@ -980,7 +983,7 @@ int dwobject::object_still_stopped(int obj_index) {
 
 
 // 0 = error (bad position), 1 = stopped, 2 = moved
-int dwobject::surface_advance() {
+int dwobject::surface_advance(phys_step_t const &step) {
 
 	obj_type const &otype(object_types[type]);
 	
@@ -1033,8 +1036,8 @@ int dwobject::surface_advance() {
 	}
 	float const vmult((otype.flags & OBJ_IS_DROP) ? 0.0 : pow(max((1.0f - friction), 0.0f), fticks)); // droplets stick - no momentum
 	velocity = (mesh_vel*(1.0 - vmult) + velocity*vmult);
-	pos.x   += velocity.x*tstep;
-	pos.y   += velocity.y*tstep;
+	pos.x   += velocity.x*step.tstep;
+	pos.y   += velocity.y*step.tstep;
 	pos.z    = mh + radius;
 	return val+1;
 }
@@ -1082,7 +1085,7 @@ void dwobject::set_orient_for_coll(vector3d const *const forced_norm) {
 }
 
 
-int dwobject::check_water_collision(float vz_old) {
+int dwobject::check_water_collision(float vz_old, phys_step_t const &step) {
 
 	if (world_mode != WMODE_GROUND) return 0;
 	obj_type const &otype(object_types[type]);
@@ -1122,7 +1125,7 @@ int dwobject::check_water_collision(float vz_old) {
 
 					if ((zpos - pos.z) > 2.0f*radius) { // under the surface
 						velocity.z  = vz_old;
-						velocity.z -= ((density - WATER_DENSITY)/density)*base_gravity*GRAVITY*tstep;
+						velocity.z -= ((density - WATER_DENSITY)/density)*base_gravity*GRAVITY*step.tstep;
 						flags      |= Z_STOPPED;
 						if ((pos.z - radius) > water_height) splash = 1;
 					}
@@ -1604,31 +1607,59 @@ bool physics_particle_manager::is_pos_valid(point const &pos) const {
 	return (pos.z > mesh_height[ypos][xpos] && pos.z > water_matrix[ypos][xpos]); // above mesh and water
 }
 
+void physics_particle_manager::add_particle(point const &p, vector3d const &v, colorRGBA const &c) {
+
+	ppos.push_back(p);
+	vel.push_back(v);
+	colors.push_back(color_wrapper());
+	colors.back().set_c4(c);
+}
+
+void physics_particle_manager::remove_dead_particles() { // stable compaction using keep flags
+
+	unsigned const num(size());
+	assert(keep.size() == num);
+	unsigned o(0);
+
+	for (unsigned i = 0; i < num; ++i) {
+		if (!keep[i]) continue;
+		if (o != i) {ppos[o] = ppos[i]; vel[o] = vel[i]; colors[o] = colors[i];}
+		++o;
+	}
+	ppos.resize(o);
+	vel.resize(o);
+	colors.resize(o);
+}
+
 void physics_particle_manager::apply_physics(float gravity, float terminal_velocity, bool emissive) {
 
-	if (parts.empty()) return;
+	if (empty()) return;
 	//RESET_TIME;
-	unsigned o(0);
-	float const g_acc(base_gravity*GRAVITY*tstep*gravity), xy_damp(pow(0.98f, fticks));
-
-	for (unsigned i = 0; i < parts.size(); ++i) {
-		part_t &part(parts[i]);
-		part.v.z  = max(-terminal_velocity, (part.v.z - g_acc)); // apply gravity + terminal velocity
-		part.v.x *= xy_damp;
-		part.v.y *= xy_damp;
-		//point const p0(part.p);
-		part.p   += tstep*part.v; // add velocity to position
-		if (emissive) {part.c.set_c3(colorRGBA(1.0, 1.0-0.75*max(0.0f, -part.v.z/terminal_velocity), 0.0));} // varies from yellow to red-orange based on vz/vt
-		int cindex;
-		
-		//if (check_coll_line(p0, part.p, cindex, -1, 1, 0)) { // skip dynamic
-		if (check_point_contained_tree(part.p, cindex, 0)) { // skip dynamic
-			continue; // destroy particle, don't bounce
-			//part.p = cpos; vector3d bounce_v; calc_reflection_angle(part.v.get_norm(), bounce_v, cnorm); part.v = 0.9*part.v.mag()*bounce_v;
+	unsigned const num(size());
+	float const g_acc(base_gravity*GRAVITY*tstep*gravity), xy_damp(pow(0.98f, fticks)), ts(tstep);
+	point *const p(ppos.data());
+	vector3d *const v(vel.data());
+
+	for (unsigned i = 0; i < num; ++i) { // integrate: no branches or calls, so this can be vectorized
+		v[i].z  = max(-terminal_velocity, (v[i].z - g_acc)); // apply gravity + terminal velocity
+		v[i].x *= xy_damp;
+		v[i].y *= xy_damp;
+		p[i]   += ts*v[i]; // add velocity to position
+	}
+	if (emissive) {
+		for (unsigned i = 0; i < num; ++i) { // varies from yellow to red-orange based on vz/vt
+			colors[i].set_c3(colorRGBA(1.0, 1.0-0.75*max(0.0f, -v[i].z/terminal_velocity), 0.0));
 		}
-		if (is_pos_valid(part.p)) {parts[o++] = part;} // above water and mesh - copy/compact
 	}
-	parts.resize(o);
+	keep.resize(num);
+
+#pragma omp parallel for schedule(static,256) if (num > 1024)
+	for (int i = 0; i < (int)num; ++i) { // validity tests are read-only, so they can run in parallel
+		int cindex(-1);
+		// destroy particles that are below the mesh/water or inside a static cobj; don't bounce
+		keep[i] = (is_pos_valid(p[i]) && !check_point_contained_tree(p[i], cindex, 0)); // skip dynamic
+	}
+	remove_dead_particles();
 	//PRINT_TIME("Particle Physics"); // 0.07ms average / 0.24ms with collisions
 }
 
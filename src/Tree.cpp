@@ -44,9 +44,9 @@ tree_type tree_types[NUM_TREE_TYPES] = { // not const - config file can override
 	tree_type(BARK6_TEX, PAPAYA_TEX,   1.0, 1.0, 1.0, 1.00, 2.0, 2.0, 0.5, 0.1,  0.0, colorRGBA(0.7, 0.6,  0.5,  1.0), WHITE)
 };
 
-vector<tree_cylin >   tree_builder_t::cylin_cache;
-vector<tree_branch>   tree_builder_t::branch_cache;
-vector<tree_branch *> tree_builder_t::branch_ptr_cache;
+thread_local vector<tree_cylin >   tree_builder_t::cylin_cache;
+thread_local vector<tree_branch>   tree_builder_t::branch_cache;
+thread_local vector<tree_branch *> tree_builder_t::branch_ptr_cache;
 
 
 bool has_any_billboard_coll(0), next_has_any_billboard_coll(0), tree_4th_branches(0);
@@ -1495,8 +1495,9 @@ bool adjust_tree_zval(point &pos, int size, int type, bool create_bush, tile_t c
 
 //gen_tree(pos, size, ttype>=0, calc_z, 0, 1);
 //gen_tree(pos, 0, -1, 1, 1, 0);
+// if gen_jobs is non-null, tree data generation and the rest of the setup is deferred to run_gen_job() and finish_gen_tree(), which the caller must call
 void tree::gen_tree(point const &pos, int size, int ttype, int calc_z, bool add_cobjs, bool user_placed, rand_gen_t &rgen,
-	float height_scale, float br_scale_mult, float nl_scale, bool has_4th_branches, bool allow_bushes, bool force_bushes)
+	float height_scale, float br_scale_mult, float nl_scale, bool has_4th_branches, bool allow_bushes, bool force_bushes, vector<tree_gen_job_t> *gen_jobs)
 {
 	//assert(calc_z || user_placed);
 	tree_center      = pos;
@@ -1540,10 +1541,40 @@ void tree::gen_tree(point const &pos, int size, int ttype, int calc_z, bool add_
 		float const hscale((height_scale == 1.0) ? treetype.height_scale : height_scale);
 		float const br_scale((br_scale_mult == 1.0) ? treetype.branch_radius : br_scale_mult);
 		float const bbo_scale((height_scale == 1.0) ? treetype.branch_break_off : 1.0);
-		td.gen_tree_data(type, size, tree_depth, hscale, br_scale, nl_scale, bbo_scale, has_4th_branches, (use_clip_cube ? &cc : NULL), create_bush, rgen); // create the tree here
+
+		if (gen_jobs) { // caller sets tree_ix
+			tree_gen_job_t job;
+			job.type  = type;
+			job.size  = size;
+			job.tree_depth   = tree_depth;
+			job.height_scale = hscale;
+			job.br_scale     = br_scale;
+			job.nl_scale     = nl_scale;
+			job.bbo_scale    = bbo_scale;
+			job.has_4th_branches = has_4th_branches;
+			job.create_bush      = create_bush;
+			job.use_clip_cube    = use_clip_cube;
+			job.clip_cube        = cc;
+			job.rgen             = rgen;
+			gen_jobs->push_back(job);
+			td.set_gen_pending(type); // so that later trees sharing td see it as created
+		}
+		else {
+			td.gen_tree_data(type, size, tree_depth, hscale, br_scale, nl_scale, bbo_scale, has_4th_branches, (use_clip_cube ? &cc : NULL), create_bush, rgen); // create the tree here
+		}
 	}
 	assert(type < NUM_TREE_TYPES);
-	unsigned const nleaves(td.get_leaves().size());
+	if (!gen_jobs) {finish_gen_tree(add_cobjs);}
+}
+
+void tree::run_gen_job(tree_gen_job_t const &job) {
+	rand_gen_t rgen(job.rgen);
+	tdata().gen_tree_data(job.type, job.size, job.tree_depth, job.height_scale, job.br_scale, job.nl_scale, job.bbo_scale,
+		job.has_4th_branches, (job.use_clip_cube ? &job.clip_cube : NULL), job.create_bush, rgen);
+}
+
+void tree::finish_gen_tree(bool add_cobjs) {
+	unsigned const nleaves(tdata().get_leaves().size());
 	damage_scale = (nleaves ? 1.0/nleaves : 0.0);
 	damage       = 0.0;
 	if (add_cobjs) {add_tree_collision_objects();}
@@ -1556,6 +1587,7 @@ void tree_data_t::gen_tree_data(int tree_type_, int size, float tree_depth, floa
 	//RESET_TIME;
 	tree_type = tree_type_;
 	has_4th_branches = has_4th_branches_;
+	gen_pending = 0;
 	assert(tree_type < NUM_TREE_TYPES);
 	leaf_data.clear();
 	clear_vbo_ixs();
@@ -2226,6 +2258,8 @@ void tree_cont_t::gen_trees_tt_within_radius(int x1, int y1, int x2, int y2, poi
 	bool const allow_bushes(max_unique_trees == 0 || !have_cities()); // allow bushes unless there are cities, because we don't want instanced bushes placed there
 	shared_tree_data.ensure_init();
 	mesh_xy_grid_cache_t density_gen[NUM_TREE_TYPES+1];
+	vector<tree_gen_job_t> gen_jobs; // tree data generated in parallel after placement
+	unsigned const first_new_tree(size());
 
 	if (NONUNIFORM_TREE_DEN) { // i==0 is the coverage density map, i>0 are the per-tree type coverage maps
 #pragma omp parallel for schedule(dynamic) num_threads(2)
@@ -2281,9 +2315,18 @@ void tree_cont_t::gen_trees_tt_within_radius(int x1, int y1, int x2, int y2, poi
 				if (!adjust_tree_zval(pos, 0, ttype, 0, cur_tile)) continue; // create_bush=0
 			}
 			add_new_tree(rgen, ttype);
-			back().gen_tree(pos, 0, ttype, 0, 1, 0, rgen, 1.0, 1.0, 1.0, tree_4th_branches, allow_bushes);
+			unsigned const num_jobs(gen_jobs.size());
+			back().gen_tree(pos, 0, ttype, 0, 1, 0, rgen, 1.0, 1.0, 1.0, tree_4th_branches, allow_bushes, 0, &gen_jobs); // rgen is reseeded per tree
+			if (gen_jobs.size() > num_jobs) {gen_jobs.back().tree_ix = size()-1;}
 		} // for j
 	} // for i
+	// generate tree data in parallel; each job has its own rgen and a unique tree_data_t (private or shared), and builders use per-thread scratch space
+#pragma omp parallel for schedule(dynamic)
+	for (int i = 0; i < (int)gen_jobs.size(); ++i) {
+		tree_gen_job_t const &job(gen_jobs[i]);
+		operator[](job.tree_ix).run_gen_job(job);
+	}
+	for (unsigned i = first_new_tree; i < size(); ++i) {operator[](i).finish_gen_tree(1);} // in placement order, since this adds cobjs
 	calc_bcube();
 }
 
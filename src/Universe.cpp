@@ -64,6 +64,7 @@ point univ_sun_pos(all_zeros);
 colorRGBA sun_color(SUN_LT_C);
 s_object current;
 universe_t universe; // the top level universe
+uobj_reclaimer_t uobj_reclaimer;
 vector<uobject const *> show_info_uobjs;
 
 
@@ -146,12 +147,11 @@ void setup_universe_fog(s_object const &closest) {
 }
 
 
-// Note: not threadsafe
 uobject *line_intersect_universe(point const &start, vector3d const &dir, float length, float line_radius, float &dist) {
 
 	point coll;
 	s_object target;
-	static line_query_state lqs;
+	static thread_local line_query_state lqs; // per-thread, since this is called from both the ship and drawing threads
 
 	if (universe.get_trajectory_collisions(lqs, target, coll, dir, start, length, line_radius)) { // destroy, query, beams
 		if (target.is_solid()) {
@@ -875,14 +875,14 @@ void ucell::draw_systems(ushader_group &usg, s_object const &clobj, unsigned pas
 				float const sradius(sol.sun.radius);
 
 				if (max_size*sradius < 0.1f*STAR_MAX_SIZE) {
-					if (!sel_g) sol.free_uobj();
+					if (!sel_g) uobj_reclaimer.free_system(sol);
 					continue;
 				}
 				point_d const spos(pos + sol.pos);
 				float const sizes(calc_sphere_size(spos, camera, sradius));
 
 				if (sizes < 0.1) {
-					if (!sel_g) sol.free_uobj();
+					if (!sel_g) uobj_reclaimer.free_system(sol);
 					continue;
 				}
 				bool const update_pass(sel_g && !no_move && ((int(tfticks)+j)&31) == 0);
@@ -922,7 +922,7 @@ void ucell::draw_systems(ushader_group &usg, s_object const &clobj, unsigned pas
 						set_universe_ambient_color(sol.get_galaxy_color());
 					}
 					else { // we know all planets are too far away
-						if (!sel_g) sol.free_planets(); // optional
+						if (!sel_g) uobj_reclaimer.free_system_planets(sol); // optional
 						if (!update_pass) continue;
 					}
 					usg.atmos_to_draw.resize(0);
@@ -940,7 +940,7 @@ void ucell::draw_systems(ushader_group &usg, s_object const &clobj, unsigned pas
 
 						if (sclip && sizep < (planet.ring_data.empty() ? 0.6 : 0.3)) {
 							if (gen_all_bodies) {planet.process();} // process anyway to ensure moons are generated for ship colonization
-							else if (!sel_g && sizep < 0.3) planet.free_uobj();
+							else if (!sel_g && sizep < 0.3) uobj_reclaimer.free_planet(planet);
 							if (update_pass) {skip_draw = 1;} else {continue;}
 						}
 						current.planet = k;
@@ -1087,6 +1087,15 @@ void universe_t::init() {
 
 	assert(U_BLOCKS & 1); // U_BLOCKS is odd
 
+	if (cells_shifted) { // cells no longer correspond to their initial positions, so regenerate them all
+		for (unsigned i = 0; i < U_BLOCKS; ++i) {
+			for (unsigned j = 0; j < U_BLOCKS; ++j) {
+				for (unsigned k = 0; k < U_BLOCKS; ++k) {cells[i][j][k].free_uobj();}
+			}
+		}
+		UNROLL_3X(cell_off[i_] = 0;)
+		cells_shifted = 0;
+	}
 	for (unsigned i = 0; i < U_BLOCKS; ++i) { // z
 		for (unsigned j = 0; j < U_BLOCKS; ++j) { // y
 			for (unsigned k = 0; k < U_BLOCKS; ++k) { // x
@@ -1101,38 +1110,65 @@ void universe_t::init() {
 void universe_t::shift_cells(int dx, int dy, int dz) {
 
 	assert((abs(dx) + abs(dy) + abs(dz)) == 1);
+	int const dxyz[3] = {dx, dy, dz};
 	vector3d const vxyz((float)dx, (float)dy, (float)dz);
+	// rotate the ring buffer rather than copying cells; the slab that falls off the trailing side is reused for the new leading side
+	UNROLL_3X(cell_off[i_] = (cell_off[i_] + U_BLOCKS + dxyz[i_])%U_BLOCKS;)
+	cells_shifted = 1;
 
 	for (unsigned i = 0; i < U_BLOCKS; ++i) { // z
 		for (unsigned j = 0; j < U_BLOCKS; ++j) { // y
 			for (unsigned k = 0; k < U_BLOCKS; ++k) { // x
-				int const i2(i + dz), j2(j + dy), k2(k + dx);
-				bool const zout(i2 < 0 || i2 >= int(U_BLOCKS));
-				bool const yout(j2 < 0 || j2 >= int(U_BLOCKS));
-				bool const xout(k2 < 0 || k2 >= int(U_BLOCKS));
-
-				if (xout || yout || zout) { // allocate new cell
-					int const ii[3]     = {(int)k, (int)j, (int)i};
-					temp.cells[i][j][k].gen = 0;
-					temp.cells[i][j][k].gen_cell(ii);
+				int const ii[3] = {(int)k, (int)j, (int)i};
+				bool is_new(0);
+				UNROLL_3X(is_new |= (ii[i_] + dxyz[i_] < 0 || ii[i_] + dxyz[i_] >= int(U_BLOCKS));)
+				ucell &cell(get_cell_xyz(k, j, i));
+
+				if (is_new) { // allocate new cell
+					cell.free_uobj();
+					cell.gen_cell(ii);
 				}
 				else {
-					cells[i2][j2][k2].gen           = 1;
-					temp.cells[i][j][k]             = cells[i2][j2][k2];
-					temp.cells[i][j][k].rel_center -= vxyz*CELL_SIZE;
+					cell.rel_center -= vxyz*CELL_SIZE;
 				}
 			}
 		}
 	}
-	for (unsigned i = 0; i < U_BLOCKS; ++i) { // z
-		for (unsigned j = 0; j < U_BLOCKS; ++j) { // y
-			for (unsigned k = 0; k < U_BLOCKS; ++k) { // x
-				if (cells[i][j][k].gen == 0) cells[i][j][k].free_uobj();
-				cells[i][j][k]     = temp.cells[i][j][k];
-				cells[i][j][k].gen = 0;
+}
+
+
+// process unprocessed galaxies in cells ahead of the camera so that their systems are generated a few at a time before they become visible,
+// rather than many at once when the player is moving quickly; returns the number of galaxies processed
+unsigned universe_t::prefetch_galaxies(point const &camera, vector3d const &dir, unsigned max_galaxies) {
+
+	if (max_galaxies == 0 || dir == zero_vector) return 0;
+	unsigned num_proc(0);
+	s_object const prev_current(current);
+
+	for (unsigned i = 0; i < U_BLOCKS && num_proc < max_galaxies; ++i) { // z
+		for (unsigned j = 0; j < U_BLOCKS && num_proc < max_galaxies; ++j) { // y
+			for (unsigned k = 0; k < U_BLOCKS && num_proc < max_galaxies; ++k) { // x
+				ucell &cell(get_cell_xyz(k, j, i));
+				if (cell.galaxies == nullptr) continue;
+				if (dot_product((cell.rel_center - camera), dir) < -CELL_SPHERE_RAD) continue; // cell is behind the camera
+				int const ii[3] = {(int)k, (int)j, (int)i};
+				UNROLL_3X(current.cellxyz[i_] = ii[i_] + uxyz[i_];)
+
+				for (unsigned g = 0; g < cell.galaxies->size() && num_proc < max_galaxies; ++g) { // process in index order, as in drawing
+					ugalaxy &galaxy((*cell.galaxies)[g]);
+					if (galaxy.gen) continue; // already processed
+					point const gpos(cell.rel_center + galaxy.pos);
+					if (dot_product((gpos - camera), dir) < -galaxy.radius) continue; // galaxy is behind the camera
+					if (calc_sphere_size(gpos, camera, STAR_MAX_SIZE, -galaxy.radius) < 0.09) continue; // beyond twice the draw distance
+					current.galaxy = g;
+					galaxy.process(cell);
+					++num_proc;
+				}
 			}
 		}
 	}
+	current = prev_current;
+	return num_proc;
 }
 
 
@@ -1363,7 +1399,7 @@ void ugalaxy::process(ucell const &cell) {
 		i->init(gen_valid_system_pos(), radius*rand_uniform2(0.005, 0.01));
 	}
 	//PRINT_TIME("Gen Asteroid Fields");
-	gen = 1;
+	publish_gen();
 }
 
 
@@ -1556,7 +1592,7 @@ void ussystem::process() {
 		asteroid_belt->init(pos, ab_radius); // gen_asteroids() will be called when drawing
 	}
 	radius = max(radius, 0.5f*(PLANET_TO_SUN_MIN_SPACING + PLANET_TO_SUN_MAX_SPACING)); // set min radius so that hyperspeed coll works
-	gen    = 1;
+	publish_gen();
 }
 
 
@@ -1703,7 +1739,7 @@ void uplanet::process() {
 	num_satellites = (unsigned short)moons.size();
 	// gas giants have atmosphere=1.0, but can have variable cloud density
 	if (gas_giant) {cloud_density = max(0.0f, rand_uniform2(-0.25, 0.75));} // Note: computed here to avoid altering the random number generator in create()
-	gen = 1;
+	publish_gen();
 }
 
 
@@ -2252,9 +2288,34 @@ void universe_t::free_context() { // should be OK even if universe isn't setup
 // *** MEMORY - FREE CODE ***
 
 
+void uobj_reclaimer_t::end_epoch() {
+
+	assert(in_epoch);
+	in_epoch = 0;
+	// free in child => parent order so that pointers into parent containers remain valid; freeing twice is a no-op
+	for (uplanet *p : planets) {p->free_uobj();}
+	for (ussystem *s : system_planets) {s->free_planets();}
+	for (ussystem *s : systems) {s->free_uobj();}
+	planets.clear();
+	system_planets.clear();
+	systems.clear();
+}
+
+void uobj_reclaimer_t::free_planet(uplanet &planet) {
+	if (in_epoch) {planets.push_back(&planet);} else {planet.free_uobj();}
+}
+void uobj_reclaimer_t::free_system_planets(ussystem &sol) {
+	if (in_epoch) {system_planets.push_back(&sol);} else {sol.free_planets();}
+}
+void uobj_reclaimer_t::free_system(ussystem &sol) {
+	if (in_epoch) {systems.push_back(&sol);} else {sol.free_uobj();}
+}
+
+
 void ucell::free_uobj() {
 
 	gen = 0;
+	cached_stars_valid = 0;
 
 	if (galaxies != nullptr) {
 		for (vector<ugalaxy>::iterator i = galaxies->begin(); i != galaxies->end(); ++i) {i->free_uobj();}
@@ -2769,7 +2830,7 @@ int universe_t::get_closest_object(s_object &result, point pos, int max_level, b
 	result.init();
 
 	// find the correct cell
-	point const cell_origin(cells[0][0][0].pos);
+	point const cell_origin(get_cell_xyz(0, 0, 0).pos);
 	UNROLL_3X(result.cellxyz[i_] = int((posc[i_] - cell_origin[i_])/CELL_SIZE);)
 	
 	if (bad_cell_xyz(result.cellxyz)) {
@@ -2782,7 +2843,7 @@ int universe_t::get_closest_object(s_object &result, point pos, int max_level, b
 	pos -= cell.pos;
 	float const planet_thresh(expand*4.0*MAX_PLANET_EXTENT + r_add), moon_thresh(expand*2.0*MAX_PLANET_EXTENT + r_add);
 	float const pt_sq(planet_thresh*planet_thresh), mt_sq(moon_thresh*moon_thresh);
-	static int last_galaxy(-1), last_cluster(-1), last_system(-1);
+	static thread_local int last_galaxy(-1), last_cluster(-1), last_system(-1); // per-thread search hints, since ship queries run in parallel with drawing
 	int const first_galaxy_to_try((galaxy_hint >= 0) ? galaxy_hint : last_galaxy);
 	unsigned const ng((unsigned)cell.galaxies->size());
 	unsigned const go((first_galaxy_to_try >= 0 && first_galaxy_to_try < int(ng)) ? last_galaxy : 0);
@@ -2792,7 +2853,7 @@ int universe_t::get_closest_object(s_object &result, point pos, int max_level, b
 		unsigned gc(gc_);
 		if (gc == 0) {gc = go;} else if (gc == go) {gc = 0;}
 		ugalaxy &galaxy((*cell.galaxies)[gc]);
-		if (!galaxy.gen) continue; // not yet generated
+		if (!galaxy.is_gen()) continue; // not yet generated
 		float const distg(p2p_dist(pos, galaxy.pos));
 		if (distg > g_expand*(galaxy.radius + MAX_SYSTEM_EXTENT) + r_add) continue;
 		float const galaxy_radius(galaxy.get_radius_at((pos - galaxy.pos)/max(distg, TOLERANCE)));
@@ -2866,6 +2927,7 @@ int universe_t::get_closest_object(s_object &result, point pos, int max_level, b
 						}
 					}
 				}
+				if (!system.is_gen()) continue; // planets not yet generated, or being generated by another thread
 				unsigned const np((unsigned)system.planets.size());
 				
 				for (unsigned pc = 0; pc < np; ++pc) { // find planet
@@ -2885,7 +2947,7 @@ int universe_t::get_closest_object(s_object &result, point pos, int max_level, b
 							}
 						}
 					}
-					if (max_level == UTYPE_PLANET) continue; // planet
+					if (max_level == UTYPE_PLANET || !planet.is_gen()) continue; // planet, or moons not yet generated
 					unsigned const nm((unsigned)planet.moons.size());
 					
 					for (unsigned mc = 0; mc < nm; ++mc) { // find moon
@@ -2965,7 +3027,7 @@ bool universe_t::get_trajectory_collisions(line_query_state &lqs, s_object &resu
 	point end(start + dir*dist);
 
 	// calculate cell block boundaries
-	point const p_low(cells[0][0][0].pos), p_hi(cells[U_BLOCKS-1][U_BLOCKS-1][U_BLOCKS-1].pos);
+	point const p_low(get_cell_xyz(0, 0, 0).pos), p_hi(get_cell_xyz(U_BLOCKS-1, U_BLOCKS-1, U_BLOCKS-1).pos);
 
 	for (unsigned d = 0; d < 3; ++d) {
 		c1[d] = p_low[d] - CELL_SIZEo2;
@@ -3049,7 +3111,7 @@ bool universe_t::get_trajectory_collisions(line_query_state &lqs, s_object &resu
 
 		for (unsigned gc = 0; gc < gv.size(); ++gc) {
 			ugalaxy &galaxy(galaxies[gv[gc].index]);
-			if (!galaxy.gen) continue; // not yet generated
+			if (!galaxy.is_gen()) continue; // not yet generated
 
 			if (include_asteroids) { // asteroid fields
 				for (vector<uasteroid_field>::const_iterator i = galaxy.asteroid_fields.begin(); i != galaxy.asteroid_fields.end(); ++i) {
@@ -3120,7 +3182,9 @@ bool universe_t::get_trajectory_collisions(line_query_state &lqs, s_object &resu
 						pv.push_back(ctest); // line intersects sun
 					}
 				}
-				for (unsigned i = 0; i < system.planets.size(); ++i) { // search for planets
+				unsigned const np(system.is_gen() ? system.planets.size() : 0); // skip planets that may be under construction
+
+				for (unsigned i = 0; i < np; ++i) { // search for planets
 					uplanet &planet(system.planets[i]);
 					float const p_radius(planet.mosize);
 					if (!dist_less_than(curr, planet.pos, (p_radius + dist))) continue;
@@ -3161,7 +3225,9 @@ bool universe_t::get_trajectory_collisions(line_query_state &lqs, s_object &resu
 					else {
 						ctest.dist = 2.0*dist;
 					}
-					for (unsigned i = 0; i < planet.moons.size(); ++i) { // search for moons
+					unsigned const nm(planet.is_gen() ? planet.moons.size() : 0);
+
+					for (unsigned i = 0; i < nm; ++i) { // search for moons
 						umoon const &moon(planet.moons[i]);
 
 						if (moon.is_ok()) {
@@ -3236,6 +3302,7 @@ bool get_gravity(s_object &result, point pos, vector3d &gravity, int offset) {
 	ussystem const &system(result.get_system());
 	pos -= result.get_ucell().pos;
 	system.sun.add_gravity_vector(gravity, pos); // add sun's gravity
+	if (!system.is_gen()) return 1; // no planets yet
 	
 	for (unsigned i = 0; i < system.planets.size(); ++i) { // add planets' gravity
 		system.planets[i].add_gravity_vector(gravity, pos);
@@ -18,6 +18,7 @@ bool const ORBITAL_REGEN      = 0;
 bool const PRINT_OWNERSHIP    = 0;
 bool const PLAYER_SLOW_PLANET_APPROACH = 1;
 unsigned const GRAV_CHECK_MOD = 4; // must be a multiple of 2
+unsigned const PREFETCH_GALAXIES_PER_FRAME = 1; // galaxies ahead of the player to generate systems for each frame
 
 
 float last_temp(-100.0);
@@ -46,6 +47,7 @@ extern vector<cached_obj> stat_objs;
 extern vector<temp_source> temp_sources;
 extern vector<hyper_inhibit_t> hyper_inhibits;
 extern universe_t universe;
+extern uobj_reclaimer_t uobj_reclaimer;
 
 
 void process_univ_objects();
@@ -288,16 +290,21 @@ void draw_universe(bool static_only, bool skip_closest, bool no_move, int no_dis
 	}
 	// clobj0 will not be set - need to draw cells before there are any sobjs
 #ifdef _OPENMP
-	// disable multiple threads when the player is away from the starting galaxy center to avoid crashing when allocating/freeing galaxies, systems, and clusters
-	bool const near_init_galaxy(dist_less_than(get_player_pos2(), universe_origin, GALAXY_MIN_SIZE));
-
-	if (inited && !static_only && NUM_THREADS > 1 && !(display_mode & 0x40) && near_init_galaxy) {
-		// is this legal when a query object that tries to access a planet/moon/star through clobj as the uobject is being deleted?
+	if (inited && !static_only && NUM_THREADS > 1 && !(display_mode & 0x40)) {
+		// shared state written while the ship thread runs in parallel with drawing:
+		// - systems and planets freed by drawing are deferred until both threads are done, since ship queries may still reference them
+		// - newly generated objects are only visible to queries once their gen flag is published; cells are only shifted after this block
+		// - planet surfaces/heightmaps are (re)generated by drawing and read by ship collisions; both sides use the planet_surface critical section
+		// - camera filters are added by both threads under the add_camera_filter critical section
+		// - the search hint statics in get_closest_object() and the line_intersect_universe() query state are thread_local
+		// - global_rand_gen, textures, and VBOs are only used by drawing; uobjs, blasts, explosions, owner counts, and the statics in ship*.cpp only by ships
+		uobj_reclaimer.begin_epoch();
 		#pragma omp parallel num_threads(2)
 		{
 			if (omp_get_thread_num_3dw() == 1) {process_ships(timer1);}
 			else {draw_universe_all(static_only, skip_closest, no_move, no_distant, gen_only, no_asteroid_dust);} // *must* be done by master thread
 		}
+		uobj_reclaimer.end_epoch(); // must be on the master thread, since this can free textures
 	}
 	else
 #endif
@@ -316,6 +323,11 @@ void draw_universe(bool static_only, bool skip_closest, bool no_move, int no_dis
 		check_gl_error(123);
 		if (TIMETEST) PRINT_TIME(" Free Obj Draw");
 	}
+	if (!gen_only && !static_only && !no_move) {
+		point const camera(get_player_pos());
+		universe.prefetch_galaxies(camera, get_player_velocity(), PREFETCH_GALAXIES_PER_FRAME);
+		if (TIMETEST) PRINT_TIME(" Galaxy Prefetch");
+	}
 	check_shift_universe();
 	disable_light(get_universe_ambient_light(1)); // for universe draw
 	enable_light(0);
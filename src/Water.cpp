@@ -694,6 +694,77 @@ inline void update_water_edges(int i, int j) {
 }
 
 
+inline bool is_ripple_active(int i, int j) { // cells that propagate ripples
+	return (wminside[i][j] && !(water_matrix[i][j] < z_min_matrix[i][j]) /*&& get_water_enabled(j, i)*/);
+}
+
+// Computes the updated acceleration of ripple cell (i,j) in gather form, with the same result as the previous scatter form where each active cell
+// in row-major order attenuated its own acceleration, subtracted its differences with its 8 neighbors, and added them to the neighbors in its inside8 mask
+float gather_ripple_acc(int i, int j, float rm_atten, bool &has_acc) {
+
+	// 00 0- -0 0+ +0 -- +- ++ -+  22  11
+	// 01 02 04 08 10 20 40 80 100 200 400
+	static short const scatter_bits[3][3] = {{0x20, 0x04, 0x100}, {0x02, 0x00, 0x08}, {0x40, 0x10, 0x80}}; // indexed by {dy+1, dx+1} from the scattering cell
+	// ripple value of cell (y,x) as seen by a cell processed after it (active cells clamp small values when processed) or before it
+	auto seen_rval = [](int y, int x, bool after) {
+		float v(ripples[y][x].rval);
+		if (after && is_ripple_active(y, x)) {fix_fp_mag(v);}
+		return v;
+	};
+	bool const active(is_ripple_active(i, j));
+	float const rmij(seen_rval(i, j, 1));
+	float acc(ripples[i][j].acc);
+
+	auto add_from = [&](int dy, int dx) { // acceleration scattered into this cell by neighbor (i+dy, j+dx)
+		int const y(i + dy), x(j + dx);
+		if (point_outside_mesh(x, y) || !is_ripple_active(y, x) || !(watershed_matrix[y][x].inside8 & scatter_bits[1-dy][1-dx])) return;
+		bool const nbr_first(dy < 0 || (dy == 0 && dx < 0));
+		float dz(seen_rval(y, x, 1) - seen_rval(i, j, (active && !nbr_first)));
+		if (dy != 0 && dx != 0) {dz *= SQRTOFTWOINV;}
+		acc += dz;
+	};
+	// neighbors processed before this cell
+	add_from(-1, -1); add_from(-1, 0); add_from(-1, 1); add_from(0, -1);
+
+	if (active) {
+		fix_fp_mag(acc);
+		acc *= rm_atten;
+		if (fabs(acc) > 1.0E-6) {has_acc = 1;}
+
+		if (point_interior_to_mesh(j, i)) { // fast mode
+			float const d0( rmij - seen_rval(i,   j-1, 1));
+			float const d2( rmij - seen_rval(i,   j+1, 0));
+			float const d4((rmij - seen_rval(i-1, j-1, 1))*SQRTOFTWOINV);
+			float const d1( rmij - seen_rval(i-1, j,   1));
+			float const d7((rmij - seen_rval(i-1, j+1, 1))*SQRTOFTWOINV);
+			float const d5((rmij - seen_rval(i+1, j-1, 0))*SQRTOFTWOINV);
+			float const d3( rmij - seen_rval(i+1, j,   0));
+			float const d6((rmij - seen_rval(i+1, j+1, 0))*SQRTOFTWOINV);
+			acc -= d0 + d1 + d2 + d3 + d4 + d5 + d6 + d7;
+		}
+		else {
+			if (j > 0) {
+				acc -= rmij - seen_rval(i, j-1, 1);
+				if (i > 0)             {acc -= (rmij - seen_rval(i-1, j-1, 1))*SQRTOFTWOINV;}
+				if (i < MESH_Y_SIZE-1) {acc -= (rmij - seen_rval(i+1, j-1, 0))*SQRTOFTWOINV;}
+			}
+			if (i > 0) {acc -= rmij - seen_rval(i-1, j, 1);}
+
+			if (j < MESH_X_SIZE-1) {
+				acc -= rmij - seen_rval(i, j+1, 0);
+				if (i < MESH_Y_SIZE-1) {acc -= (rmij - seen_rval(i+1, j+1, 0))*SQRTOFTWOINV;}
+				if (i > 0)             {acc -= (rmij - seen_rval(i-1, j+1, 1))*SQRTOFTWOINV;}
+			}
+			if (i < MESH_Y_SIZE-1) {acc -= rmij - seen_rval(i+1, j, 0);}
+		}
+		fix_fp_mag(acc);
+	}
+	// neighbors processed after this cell
+	add_from(0, 1); add_from(1, -1); add_from(1, 0); add_from(1, 1);
+	return acc;
+}
+
+
 void compute_ripples() {
 
 	if (DISABLE_WATER) return;
@@ -706,89 +777,27 @@ void compute_ripples() {
 		float const rm_atten(pow(RIPPLE_MAT_ATTEN, tstep)), rdamp1(pow(RIPPLE_DAMP1, tstep)), rdamp2(RIPPLE_DAMP2*tstep);
 		start_ripple = 0;
 
+		static vector<float> new_acc;
+		new_acc.resize(XY_MULT_SIZE);
+		int has_acc(0);
+
+		// compute all accelerations first, since cells read the ripple values of their neighbors; each row can be processed independently
+#pragma omp parallel for schedule(static) reduction(|:has_acc)
 		for (int i = 0; i < MESH_Y_SIZE; ++i) {
 			for (int j = 0; j < MESH_X_SIZE; ++j) {
-				if (!wminside[i][j] || water_matrix[i][j] < z_min_matrix[i][j] /*|| !get_water_enabled(j, i)*/) continue;
-				short const i8(watershed_matrix[i][j].inside8);
-				fix_fp_mag(ripples[i][j].rval);
-				float const rmij(ripples[i][j].rval);
-				float &acc(ripples[i][j].acc);
-				fix_fp_mag(acc);
-				acc *= rm_atten;
-				if (!start_ripple && fabs(acc) > 1.0E-6) start_ripple = 1;
-
-				// 00 0- -0 0+ +0 -- +- ++ -+  22  11
-				// 01 02 04 08 10 20 40 80 100 200 400
-				if (point_interior_to_mesh(j, i)) { // fast mode
-					float const d0( rmij - ripples[i  ][j-1].rval);
-					if (i8 & 0x02)  ripples[i  ][j-1].acc += d0;
-					float const d2( rmij - ripples[i  ][j+1].rval);
-					if (i8 & 0x08)  ripples[i  ][j+1].acc += d2;
-					float const d4((rmij - ripples[i-1][j-1].rval)*SQRTOFTWOINV);
-					if (i8 & 0x20)  ripples[i-1][j-1].acc += d4;
-					float const d1( rmij - ripples[i-1][j  ].rval);
-					if (i8 & 0x04)  ripples[i-1][j  ].acc += d1;
-					float const d7((rmij - ripples[i-1][j+1].rval)*SQRTOFTWOINV);
-					if (i8 & 0x100) ripples[i-1][j+1].acc += d7;
-					float const d5((rmij - ripples[i+1][j-1].rval)*SQRTOFTWOINV);
-					if (i8 & 0x40)  ripples[i+1][j-1].acc += d5;
-					float const d3( rmij - ripples[i+1][j  ].rval);
-					if (i8 & 0x10)  ripples[i+1][j  ].acc += d3;
-					float const d6((rmij - ripples[i+1][j+1].rval)*SQRTOFTWOINV);
-					if (i8 & 0x80)  ripples[i+1][j+1].acc += d6;
-					acc -= d0 + d1 + d2 + d3 + d4 + d5 + d6 + d7;
-					fix_fp_mag(acc);
-					continue;
-				}
-				if (j > 0) {
-					float const dz(rmij - ripples[i][j-1].rval);
-					if (i8 & 0x02) ripples[i][j-1].acc += dz;
-					acc -= dz;
-
-					if (i > 0) {
-						float const dz((rmij - ripples[i-1][j-1].rval)*SQRTOFTWOINV);
-						if (i8 & 0x20) ripples[i-1][j-1].acc += dz;
-						acc -= dz;
-					}
-					if (i < MESH_Y_SIZE-1) {
-						float const dz((rmij - ripples[i+1][j-1].rval)*SQRTOFTWOINV);
-						if (i8 & 0x40) ripples[i+1][j-1].acc += dz;
-						acc -= dz;
-					}
-				}
-				if (i > 0) {
-					float const dz(rmij - ripples[i-1][j].rval);
-					if (i8 & 0x04) ripples[i-1][j].acc += dz;
-					acc -= dz;
-				}
-				if (j < MESH_X_SIZE-1) {
-					float const dz(rmij - ripples[i][j+1].rval);
-					if (i8 & 0x08) ripples[i][j+1].acc += dz;
-					acc -= dz;
-
-					if (i < MESH_Y_SIZE-1) {
-						float const dz((rmij - ripples[i+1][j+1].rval)*SQRTOFTWOINV);
-						if (i8 & 0x80) ripples[i+1][j+1].acc += dz;
-						acc -= dz;
-					}
-					if (i > 0) {
-						float const dz((rmij - ripples[i-1][j+1].rval)*SQRTOFTWOINV);
-						if (i8 & 0x100) ripples[i-1][j+1].acc += dz;
-						acc -= dz;
-					}
-				}
-				if (i < MESH_Y_SIZE-1) {
-					float const dz(rmij - ripples[i+1][j].rval);
-					if (i8 & 0x10) ripples[i+1][j].acc += dz;
-					acc -= dz;
-				}
-				fix_fp_mag(acc);
-			} // for j
-		} // for i
+				bool cell_has_acc(0);
+				new_acc[i*MESH_X_SIZE + j] = gather_ripple_acc(i, j, rm_atten, cell_has_acc);
+				if (cell_has_acc) {has_acc = 1;}
+			}
+		}
+		start_ripple = has_acc;
 		if (DEBUG_RIPPLE_TIME) dtime1 += GET_DELTA_TIME;
 		
+#pragma omp parallel for schedule(static)
 		for (int i = 0; i < MESH_Y_SIZE; ++i) {
 			for (int j = 0; j < MESH_X_SIZE; ++j) {
+				if (is_ripple_active(i, j)) {fix_fp_mag(ripples[i][j].rval);} // must be done before updating water_matrix
+				ripples[i][j].acc = new_acc[i*MESH_X_SIZE + j];
 				float ripple_zval(0.0);
 
 				if (wminside[i][j]) {
@@ -53,7 +53,7 @@ extern bool clear_landscape_vbo, use_voxel_cobjs, tree_4th_branches, lm_alloc, r
 extern int camera_view, camera_mode, camera_reset, animate2, recreated, temp_change, preproc_cube_cobjs, precip_mode;
 extern int is_cloudy, num_smileys, load_coll_objs, world_mode, start_ripple, has_snow_accum, has_accumulation, scrolling, num_items, camera_coll_id;
 extern int num_dodgeballs, display_mode, game_mode, num_trees, tree_mode, has_scenery2, UNLIMITED_WEAPONS, ground_effects_level;
-extern float temperature, zmin, TIMESTEP, base_gravity, orig_timestep, fticks, tstep, sun_rot, czmax, czmin, dodgeball_metalness;
+extern float temperature, zmin, TIMESTEP, base_gravity, fticks, sun_rot, czmax, czmin, dodgeball_metalness;
 extern point cpos2, orig_camera, orig_cdir;
 extern unsigned create_voxel_landscape, scene_smap_vbo_invalid, num_dynam_parts, max_num_mat_spheres, init_item_counts[];
 extern obj_type object_types[];
@@ -383,6 +383,7 @@ void process_groups() {
 		unsigned app_rate(unsigned(((float)objg.app_rate)*fticks_max));
 		if (objg.app_rate > 0 && fticks > 0 && app_rate == 0) {app_rate = 1;}
 		float const time(TIMESTEP*fticks_max), grav_dz(min(otype.terminal_vel*time, base_gravity*GRAVITY*time*time*otype.gravity));
+		phys_step_t const frame_step(get_frame_phys_step());
 		size_t const max_objs(objg.max_objects());
 		bool const reflective(reflect_dodgeballs && type == BALL && enable_all_reflections()); // Note: cobjs only have a lifetime of one frame
 		cobj_params cp(otype.elasticity, otype.color, reflective, 1, coll_func, -1, otype.tid, 1.0, 0, 0);
@@ -490,21 +491,17 @@ void process_groups() {
 
 							if (spf > 1) {
 								assert(fticks > 0.0);
-								orig_timestep = TIMESTEP; // incremental multistep object advance
-								TIMESTEP     /= float(spf);
-								tstep         = TIMESTEP*fticks;
+								phys_step_t const substep(frame_step.get_substep(spf)); // incremental multistep object advance
 								point const obj_pos(obj.pos);
 								
 								for (unsigned k = 0; k < spf; ++k) {
-									obj.advance_object(!recreated, k, j);
+									obj.advance_object(!recreated, k, j, substep);
 									if (obj.status != 1)    break; // no longer airborne
 									if (obj.pos == obj_pos) break; // stopped
 								}
-								TIMESTEP = orig_timestep;
-								tstep    = time;
 							}
 						}
-						if (spf == 1) {obj.advance_object(!recreated, 0, j);}
+						if (spf == 1) {obj.advance_object(!recreated, 0, j, frame_step);}
 						obj.verify_data();
 						
 						if (!obj.disabled() && cindex >= 0 && !large_radius && spf < LG_STEPS_PER_FRAME) { // test collision with this cobj
@@ -817,6 +814,25 @@ void coll_obj_group::clear() { // unused, but may be useful
 	clear_ids();
 }
 
+// hash of the geometry and placement-relevant properties of static cobjs only; used to validate data derived from static cobjs;
+// dynamic and unused cobjs and cobj indices are not included, so callers that store cobj indices must hash those separately
+unsigned coll_obj_group::get_static_geom_hash() const {
+
+	unsigned hv(0);
+
+	for (const_iterator i = begin(); i != end(); ++i) {
+		if (i->status != COLL_STATIC) continue;
+		hash_mix_point(i->get_llc(), hv);
+		hash_mix_point(i->get_urc(), hv);
+		hash_mix_point(point(i->type, i->npoints, i->radius), hv);
+		hash_mix_point(point(i->radius2, i->thickness, i->platform_id), hv);
+		hash_mix_point(point(i->cp.surfs, i->cp.flags, i->cp.cobj_type), hv);
+		hash_mix_point(i->norm, hv);
+		for (int n = 0; n < i->npoints; ++n) {hash_mix_point(i->points[n], hv);}
+	}
+	return hv;
+}
+
 
 void coll_obj_group::finalize() {
 
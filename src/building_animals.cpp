@@ -33,12 +33,15 @@ bool phone_is_ringing();
 unsigned get_fishtank_coll_cubes(room_object_t const &c, cube_t cubes[7]);
 template<typename T> bool line_int_cubes_exp(point const &p1, point const &p2, vector<T> const &cubes, vector3d const &expand, cube_t const &line_bcube);
 
+float    const ANIMAL_SIM_TIMESTEP  = 0.5; // in ticks; 80Hz
+unsigned const MAX_ANIMAL_SIM_STEPS = 8;   // per frame; limits sim time to 100ms per frame
 
-void building_animal_t::sleep_for(float time_secs_min, float time_secs_max) {
-	wake_time = (float)tfticks + rand_uniform(time_secs_min, time_secs_max)*TICKS_PER_SECOND;
+
+void building_animal_t::sleep_for(float cur_time, float time_secs_min, float time_secs_max, rand_gen_t &rgen) { // cur_time is in ticks
+	wake_time = cur_time + rgen.rand_uniform(time_secs_min, time_secs_max)*TICKS_PER_SECOND;
 	dist_since_sleep = 0.0; // reset the counter
 }
-float building_animal_t::move(float timestep, bool can_move_forward, float anim_time_scale) { // returns movement distance
+float building_animal_t::move(float cur_time, float timestep, bool can_move_forward, float anim_time_scale) { // returns movement distance
 	// update animation time using position change; note that we can't just do the update in the rat movement code below because pos may be reset in case of collision
 	anim_time += anim_time_scale*p2p_dist(pos, last_pos)/radius; // scale with size so that small rat/spider legs move faster
 	last_pos   = pos;
@@ -46,7 +49,7 @@ float building_animal_t::move(float timestep, bool can_move_forward, float anim_
 	float move_dist(0.0);
 
 	if (is_sleeping()) {
-		if ((float)tfticks > wake_time) {wake_time = speed = 0.0;} // time to wake up
+		if (cur_time > wake_time) {wake_time = speed = 0.0;} // time to wake up
 	}
 	else if (speed == 0.0) {
 		anim_time = 0.0; // reset animation to rest pos
@@ -61,13 +64,35 @@ float building_animal_t::move(float timestep, bool can_move_forward, float anim_
 
 void building_t::update_animals(point const &camera_bs, unsigned building_ix) {
 	if (!animate2 || is_rotated() || !has_room_geom() || interior->rooms.empty()) return;
-	update_rats         (camera_bs, building_ix);
-	update_sewer_rats   (camera_bs, building_ix);
-	update_pet_rats     (camera_bs, building_ix);
-	update_spiders      (camera_bs, building_ix);
-	update_sewer_spiders(camera_bs, building_ix);
-	update_snakes       (camera_bs, building_ix);
-	update_pet_snakes   (camera_bs, building_ix);
+	// rats, spiders, and snakes are simulated with a fixed timestep so that their behavior is independent of framerate;
+	// sim time beyond the per-frame step budget is dropped, which slows the animals down rather than spiking the frame time;
+	// at high framerates (frame time below one step) a single variable step is run each frame instead, since there's no render interpolation
+	building_room_geom_t &rg(*interior->room_geom);
+	//timer_t timer("Update Animals");
+	auto run_step([&](float timestep) {
+		rg.animal_sim_clock += timestep;
+		unsigned const step_ix(++rg.animal_sim_step);
+		update_rats         (camera_bs, building_ix, timestep, step_ix);
+		update_sewer_rats   (camera_bs, building_ix, timestep, step_ix);
+		update_pet_rats     (camera_bs, building_ix, timestep, step_ix);
+		update_spiders      (camera_bs, building_ix, timestep, step_ix);
+		update_sewer_spiders(camera_bs, building_ix, timestep, step_ix);
+		update_snakes       (camera_bs, building_ix, timestep, step_ix);
+	});
+	if (fticks < ANIMAL_SIM_TIMESTEP) { // variable step, including any leftover fixed step time
+		float const timestep(fticks + rg.animal_sim_time);
+		rg.animal_sim_time = 0.0;
+		if (timestep > 0.0) {run_step(timestep);}
+	}
+	else {
+		rg.animal_sim_time = min((rg.animal_sim_time + fticks), MAX_ANIMAL_SIM_STEPS*ANIMAL_SIM_TIMESTEP);
+
+		for (unsigned n = 0; n < MAX_ANIMAL_SIM_STEPS && rg.animal_sim_time >= ANIMAL_SIM_TIMESTEP; ++n) {
+			rg.animal_sim_time -= ANIMAL_SIM_TIMESTEP;
+			run_step(ANIMAL_SIM_TIMESTEP);
+		}
+	}
+	update_pet_snakes   (camera_bs, building_ix); // pet snakes, birds, and insects are cheap and still update at the frame rate
 	update_pet_birds    (camera_bs, building_ix);
 	update_insects      (camera_bs, building_ix);
 	interior->room_geom->last_animal_update_frame = frame_counter;
@@ -305,7 +330,7 @@ bool building_t::add_rat(point const &pos, float hlength, vector3d const &dir, p
 	return 1;
 }
 
-void building_t::update_rats(point const &camera_bs, unsigned building_ix) {
+void building_t::update_rats(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix) {
 	vect_rat_t &rats(interior->room_geom->rats);
 	if (rats.placed && rats.empty()) return; // no rats placed in this building
 	if (global_building_params.num_rats_max == 0) return;
@@ -315,12 +340,13 @@ void building_t::update_rats(point const &camera_bs, unsigned building_ix) {
 		global_building_params.rat_size_min, global_building_params.rat_size_max);
 	// update rats; rats always attack when the player is dead or a phone is ringing
 	unsigned const min_attack_rats((player_wait_respawn || phone_is_ringing()) ? 1 : global_building_params.min_attack_rats);
-	float const timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
 	unsigned num_near_player(0);
 	point rat_alert_pos;
 
-	for (rat_t &rat : rats) { // must be done before sorting
-		rat.move(timestep, rat.is_facing_dest());
+	float const sim_clock(get_animal_sim_clock());
+	for (rat_t &rat : rats) {rat.move(sim_clock, timestep, rat.is_facing_dest());} // must be done before sorting
+
+	for (rat_t const &rat : rats) {
 		num_near_player += rat.near_player;
 		if (num_near_player == min_attack_rats) {rat_alert_pos = rat.pos;}
 	}
@@ -333,9 +359,9 @@ void building_t::update_rats(point const &camera_bs, unsigned building_ix) {
 	prev_can_attack_player = can_attack_player;
 	rats.do_sort();
 	rand_gen_t rgen;
-	rgen.set_state(building_ix+1, frame_counter+1); // unique per building and per frame
+	rgen.set_state(building_ix+1, step_ix); // unique per building and per sim step
 
-	if (frame_counter & 1) { // reverse iteration, to avoid directional bias
+	if (step_ix & 1) { // reverse iteration, to avoid directional bias
 		for (auto r = rats.rbegin(); r != rats.rend(); ++r) {update_rat(*r, camera_bs, timestep, rats.max_xmove, can_attack_player, rgen);}
 	}
 	else { // forward iteration; ~0.004ms per rat
@@ -343,12 +369,12 @@ void building_t::update_rats(point const &camera_bs, unsigned building_ix) {
 	}
 }
 
-void building_t::update_sewer_rats(point const &camera_bs, unsigned building_ix) {
+void building_t::update_sewer_rats(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix) {
 	vect_rat_t &rats(interior->room_geom->sewer_rats);
 	if (rats.placed && rats.empty()) return; // no sewer rats placed in this building
 	if (global_building_params.num_rats_max == 0 || interior->tunnels.empty()) return;
 	if (!building_obj_model_loader.is_model_valid(OBJ_MODEL_RAT)) return; // no rat model
-	float const floor_spacing(get_window_vspace()), timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
+	float const floor_spacing(get_window_vspace());
 	rand_gen_t rgen;
 	rgen.set_state(building_ix+1, building_ix+123); // unique per building
 	
@@ -386,7 +412,7 @@ void building_t::update_sewer_rats(point const &camera_bs, unsigned building_ix)
 				rat.speed     = 0.0;
 				rat.is_hiding = 1; // safe behind the bars
 			}
-			else {rat.move(timestep);}
+			else {rat.move(get_animal_sim_clock(), timestep);}
 		}
 		else if (player_in_tunnel && !rat.is_hiding) { // stopped and not safe
 			if (dist_xy_less_than(rat.pos, camera_bs, 2.0*floor_spacing)) { // check for player proximity
@@ -397,7 +423,7 @@ void building_t::update_sewer_rats(point const &camera_bs, unsigned building_ix)
 	} // for rat
 }
 
-void building_t::update_pet_rats(point const &camera_bs, unsigned building_ix) {
+void building_t::update_pet_rats(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix) {
 	if (!building_obj_model_loader.is_model_valid(OBJ_MODEL_RAT)) return; // no rat model
 	vect_rat_t &rats(interior->room_geom->pet_rats);
 	vect_room_object_t const &objs(interior->room_geom->objs);
@@ -422,10 +448,9 @@ void building_t::update_pet_rats(point const &camera_bs, unsigned building_ix) {
 		rats.placed = 1;
 	}
 	if (rats.empty()) return; // no pet rats placed in this building
-	float const timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
 	bool any_removed(0);
 	rand_gen_t rgen;
-	rgen.set_state(building_ix+1, frame_counter+1); // unique per building and per frame
+	rgen.set_state(building_ix+1, step_ix); // unique per building and per sim step
 	auto tank_start(rats.begin());
 
 	for (auto i = rats.begin(); i != rats.end(); ++i) { // update logic
@@ -440,14 +465,14 @@ void building_t::update_pet_rats(point const &camera_bs, unsigned building_ix) {
 			continue;
 		}
 		if (rat.is_sleeping()) {
-			if ((float)tfticks > rat.wake_time) {rat.wake_time = 0.0;} // time to wake up
+			if (get_animal_sim_clock() > rat.wake_time) {rat.wake_time = 0.0;} // time to wake up
 		}
 		else if (rat.dist_since_sleep > 0.75*(obj.dx() + obj.dy())) { // maybe stop and rest
-			rat.sleep_for(1.0, 10.0); // 2-10s
+			rat.sleep_for(get_animal_sim_clock(), 1.0, 10.0, rgen); // 2-10s
 			rat.speed = 0.0; // will reset anim_time in the next frame
 		}
 		else if (rat.speed > 0.0) { // moving
-			rat.move(timestep, 1, 0.5); // can_move_forward=1, anim_time_scale=0.5
+			rat.move(get_animal_sim_clock(), timestep, 1, 0.5); // can_move_forward=1, anim_time_scale=0.5
 			// check for invalid pos; should this be predicted with lookahead?
 			point const old_pos(rat.pos);
 			cube_t valid_area(obj);
@@ -475,7 +500,7 @@ void building_t::update_pet_rats(point const &camera_bs, unsigned building_ix) {
 				if (dot_product(rat.dest, coll_normal) > 0.0) {rat.dest.negate();} // must point away from the collision
 
 				if (rgen.rand_float() < 0.25) { // maybe stop and rest
-					rat.sleep_for(1.0, 5.0); // 1-5s
+					rat.sleep_for(get_animal_sim_clock(), 1.0, 5.0, rgen); // 1-5s
 					rat.speed = 0.0; // will reset anim_time in the next frame
 				}
 			}
@@ -606,9 +631,9 @@ public:
 dir_gen_t<1> dir_gen_xy;
 dir_gen_t<0> dir_gen_xyz;
 
-void building_t::rat_bite_player(point const &pos, float damage, rand_gen_t &rgen) {
+void building_t::rat_bite_player(point const &pos, float damage, float timestep, rand_gen_t &rgen) {
 	play_attack_sound(local_to_camera_space(pos), 1.0, 1.0, rgen);
-	bool const player_dead(player_take_damage(damage));
+	bool const player_dead(player_take_damage_over_time(damage, timestep)); // called once per sim step, so scale by the step rather than fticks
 	if (player_dead) {register_achievement("Rat Food");} // damage over time; achievement if the player dies
 	if (player_dead) {register_player_death(cur_player_building_loc.pos);}
 }
@@ -644,7 +669,7 @@ void building_t::update_rat(rat_t &rat, point const &camera_bs, float timestep,
 		// check if new pos is valid, and has a path to dest
 		if (!is_pos_inside_building(rat.pos, xy_pad, hheight)) {
 			rat.pos = prev_pos; // restore previous pos before collision
-			rat.sleep_for(0.1, 0.2); // wait 0.1-0.2s so that we don't immediately collide and get pushed out again
+			rat.sleep_for(get_animal_sim_clock(), 0.1, 0.2, rgen); // wait 0.1-0.2s so that we don't immediately collide and get pushed out again
 		}
 		else if (check_line_coll_expand((rat.pos + center_dz), (rat.dest + center_dz), coll_radius, squish_hheight)) {
 			rat.pos = prev_pos; // restore previous pos before collision
@@ -681,7 +706,7 @@ void building_t::update_rat(rat_t &rat, point const &camera_bs, float timestep,
 				rat.speed     = RAT_ATTACK_SPEED*global_building_params.rat_speed;
 				rat.wake_time = 0.0; // wake up
 				update_path   = 0;
-				if (dist_xy_less_than(rat.pos, target, 0.05*min_dist)) {rat_bite_player(rat.pos, 0.004, rgen);} // do damage when nearly colliding with the player
+				if (dist_xy_less_than(rat.pos, target, 0.05*min_dist)) {rat_bite_player(rat.pos, 0.004, timestep, rgen);} // do damage when nearly colliding with the player
 			}
 		}
 	}
@@ -774,7 +799,7 @@ void building_t::update_rat(rat_t &rat, point const &camera_bs, float timestep,
 	bool const is_at_dest(dist_less_than(rat.pos, rat.dest, dist_thresh));
 
 	if (!is_scared && !rat.is_sleeping() && is_at_dest && rat.dist_since_sleep > 1.5*floor_spacing && rgen.rand_bool()) { // 50% chance of taking a rest
-		rat.sleep_for(0.0, 4.0); // 0-4s
+		rat.sleep_for(get_animal_sim_clock(), 0.0, 4.0, rgen); // 0-4s
 		rat.speed = 0.0; // will reset anim_time in the next frame
 	}
 	else if (!has_fear_dest && !rat.is_sleeping() &&
@@ -934,7 +959,7 @@ bool building_room_geom_t::maybe_spawn_spider_in_drawer(room_object_t const &c,
 	return 1;
 }
 
-void building_t::update_spiders(point const &camera_bs, unsigned building_ix) {
+void building_t::update_spiders(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix) {
 	vect_spider_t &spiders(interior->room_geom->spiders);
 	bool const was_placed(spiders.placed);
 	if (was_placed && spiders.empty()) return; // no spiders placed in this building
@@ -963,14 +988,14 @@ void building_t::update_spiders(point const &camera_bs, unsigned building_ix) {
 		} // for t
 	}
 	// update spiders
-	float const timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
-	
+	float const sim_clock(get_animal_sim_clock());
+
 	for (spider_t &spider : spiders) {
-		if (!spider.squished) {spider.move(timestep);}
+		if (!spider.squished) {spider.move(sim_clock, timestep);}
 	}
 	spiders.do_sort();
 	rand_gen_t rgen;
-	rgen.set_state(building_ix+1, frame_counter+1); // unique per building and per frame
+	rgen.set_state(building_ix+1, step_ix); // unique per building and per sim step
 	for (spider_t &spider : spiders) {update_spider(spider, camera_bs, timestep, spiders.max_xmove, rgen);}
 }
 
@@ -978,11 +1003,11 @@ void set_spider_speed(spider_t &spider, rand_gen_t &rgen, float floor_spacing) {
 	spider.speed = global_building_params.spider_speed*rgen.rand_uniform(0.5, 1.0);
 	if (spider.in_tank) {spider.speed *= min(1.0f, 2.0f*spider.radius/(floor_spacing*global_building_params.spider_size_min));} // scale pet store spider speed with radius
 }
-void building_t::update_sewer_spiders(point const &camera_bs, unsigned building_ix) {
+void building_t::update_sewer_spiders(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix) {
 	vect_spider_t &spiders(interior->room_geom->sewer_spiders);
 	if (spiders.placed && spiders.empty()) return; // no spiders placed in this building
 	if (global_building_params.num_spiders_max == 0 || interior->tunnels.empty()) return;
-	float const floor_spacing(get_window_vspace()), timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
+	float const floor_spacing(get_window_vspace());
 	rand_gen_t rgen;
 	rgen.set_state(building_ix+1, building_ix+123); // unique per building
 
@@ -1030,7 +1055,7 @@ void building_t::update_sewer_spiders(point const &camera_bs, unsigned building_
 			}
 			if (val < v1) {spider.dir[t.dim] =  1.0;} // off low  end - reverse
 			if (val > v2) {spider.dir[t.dim] = -1.0;} // off high end - reverse
-			if (!spider.squished) {spider.move(timestep);} // can't be squished?
+			if (!spider.squished) {spider.move(get_animal_sim_clock(), timestep);} // can't be squished?
 		}
 	}
 }
@@ -1392,16 +1417,16 @@ void building_t::update_spider(spider_t &spider, point const &camera_bs, float t
 
 	// regenerate dir if collided and not on a web, or if dir is somehow bad
 	if ((had_coll && !spider.on_web) || spider.dir.mag_sq() < 0.25) {spider.choose_new_dir(rgen);}
-	else if ((float)tfticks > spider.update_time) { // direction change or sleep
+	else if (get_animal_sim_clock() > spider.update_time) { // direction change or sleep
 		if (spider.on_web) {
-			spider.update_time = (float)tfticks + 1.0*TICKS_PER_SECOND; // wait another 1s before updating
+			spider.update_time = get_animal_sim_clock() + 1.0*TICKS_PER_SECOND; // wait another 1s before updating
 		}
 		else if (spider.dist_since_sleep > 2.0*get_window_vspace() && rgen.rand_bool()) { // 50% chance of taking a rest
-			spider.sleep_for(0.1, 5.0); // 0.1-5s
+			spider.sleep_for(get_animal_sim_clock(), 0.1, 5.0, rgen); // 0.1-5s
 			spider.speed = 0.0; // will reset anim_time in the next frame
 		}
 		else {
-			spider.update_time = (float)tfticks + rand_uniform(5.0, 15.0)*TICKS_PER_SECOND; // 5-15s
+			spider.update_time = get_animal_sim_clock() + rgen.rand_uniform(5.0, 15.0)*TICKS_PER_SECOND; // 5-15s
 			vector3d const prev_dir(spider.dir);
 			spider.choose_new_dir(rgen);
 			spider.dir = (spider.dir + prev_dir).get_norm(); // 50% mix of prev and new dir to avoid sharp turns
@@ -1423,7 +1448,7 @@ void building_t::update_spider(spider_t &spider, point const &camera_bs, float t
 		// check if new pos is valid, and has a path to dest
 		if (!is_pos_inside_building(spider.pos, radius, radius)) {
 			spider.pos = prev_pos; // restore previous pos before collision
-			spider.sleep_for(0.1, 0.2); // wait 0.1-0.2s so that we don't immediately collide and get pushed out again
+			spider.sleep_for(get_animal_sim_clock(), 0.1, 0.2, rgen); // wait 0.1-0.2s so that we don't immediately collide and get pushed out again
 		}
 		else {
 			max_eq(max_xmove, fabs(spider.pos.x - prev_pos.x));
@@ -1574,16 +1599,15 @@ float snake_t::get_curve_factor() const {
 	return curve_factor / (seg_len*seg_len); // normalize based on segment length
 }
 
-void building_t::update_snakes(point const &camera_bs, unsigned building_ix) {
+void building_t::update_snakes(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix) {
 	vect_snake_t &snakes(interior->room_geom->snakes);
 	if (snakes.placed && snakes.empty()) return; // no snakes placed in this building
 	add_animals_on_floor(snakes, building_ix, global_building_params.num_snakes_min, global_building_params.num_snakes_max,
 		global_building_params.snake_size_min, global_building_params.snake_size_max);
 	// update snakes
-	float const timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
 	snakes.do_sort(); // is this necessary?
 	rand_gen_t rgen;
-	rgen.set_state(building_ix+1, frame_counter+1); // unique per building and per frame
+	rgen.set_state(building_ix+1, step_ix); // unique per building and per sim step
 	for (snake_t &snake : snakes) {update_snake(snake, camera_bs, timestep, snakes.max_xmove, rgen);}
 }
 
@@ -1678,7 +1702,7 @@ void building_t::update_snake(snake_t &snake, point const &camera_bs, float time
 		snake.dir = dir;
 		update_dir_incremental(snake.last_valid_dir, snake.dir, 1.0, timestep, rgen);
 		// move snake forward
-		float const prev_pos_x(snake.pos.x), move_dist(snake.move(timestep)); // snake moves here
+		float const prev_pos_x(snake.pos.x), move_dist(snake.move(get_animal_sim_clock(), timestep)); // snake moves here
 		snake.move_segments(move_dist);
 		max_eq(max_xmove, fabs(prev_pos_x - snake.pos.x));
 
@@ -1686,7 +1710,7 @@ void building_t::update_snake(snake_t &snake, point const &camera_bs, float time
 			vector3d const side_dir(cross_product(snake.dir, plus_z));
 			float const speed_factor(snake.speed/global_building_params.snake_speed); // [0.5, 1.0]
 			float const rot_amt(sin(0.1*snake.anim_time)); // rotation amount should be independent of speed
-			rotate_vector3d(plus_z, 0.02*fticks*PI*rot_amt*speed_factor, snake.dir);
+			rotate_vector3d(plus_z, 0.02*timestep*PI*rot_amt*speed_factor, snake.dir);
 			snake.dir.normalize(); // is this needed?
 		}
 	}
@@ -1863,7 +1887,7 @@ void building_t::update_insects(point const &camera_bs, unsigned building_ix) {
 	float const timestep(min(fticks, 4.0f)); // clamp fticks to 100ms
 
 	for (insect_t &insect : insects) {
-		if (!insect.squished) {insect.move(timestep);}
+		if (!insect.squished) {insect.move((float)tfticks, timestep);} // insects update per frame, so use tfticks
 	}
 	vector<pair<float, point>> targets; // used for flies
 	for (insect_t &insect : insects) {update_insect(insect, camera_bs, timestep, targets, rgen);}
@@ -2078,7 +2102,7 @@ void building_t::update_roach(insect_t &roach, point const &camera_bs, float tim
 	}
 	else { // slow random walk and stop
 		if (!roach.is_sleeping() && roach.dist_since_sleep > roach.dist_to_sleep) { // sleep
-			roach.sleep_for(0.0, 4.0); // 0-4s
+			roach.sleep_for((float)tfticks, 0.0, 4.0, rgen); // 0-4s
 			roach.no_scare  = 0; // allow scaring again
 			roach.speed     = 0.0;
 			roach.delta_dir = rgen.signed_rand_vector_spherical_xy_norm(); // choose a new random dir after sleep is over
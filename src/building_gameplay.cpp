@@ -1277,7 +1277,7 @@ bool building_room_geom_t::player_pickup_object(building_t &building, point cons
 			if (!r.dead && in_building_gameplay_mode()) { // maybe bite the player when picked up
 				rand_gen_t rgen;
 				rgen.set_state(frame_counter, obj_id+1);
-				if (rgen.rand_bool()) {building.rat_bite_player(at_pos, rgen.rand_uniform(0.05, 0.1), rgen);}
+				if (rgen.rand_bool()) {building.rat_bite_player(at_pos, rgen.rand_uniform(0.05, 0.1), fticks, rgen);}
 			}
 			rats.erase(rats.begin() + rat_ix); // remove the rat from the building
 			modified_by_player = 1;
@@ -2922,6 +2922,10 @@ bool flashlight_enabled() { // flashlight can't be used in tiled terrain buildin
 // should we include falling damage? currently the player can't fall down elevator shafts or stairwells,
 // and falling off building roofs doesn't count because gameplay isn't enabled because the player isn't in the building
 bool player_take_damage(float damage_scale, bool scream, int poison_type, uint8_t *has_key) {
+	return player_take_damage_over_time(damage_scale, fticks, scream, poison_type, has_key); // damage is per tick, applied over this frame
+}
+// for callers that apply damage once per fixed sim step rather than once per frame
+bool player_take_damage_over_time(float damage_scale, float timestep, bool scream, int poison_type, uint8_t *has_key) {
 	if (player_wait_respawn) return 0;
 	static double last_scream_time(0.0), last_hurt_time(0.0);
 
@@ -2938,7 +2942,7 @@ bool player_take_damage(float damage_scale, bool scream, int poison_type, uint8_
 		}
 	}
 	add_camera_filter(colorRGBA(RED, (0.13 + 3.0*damage_scale)), 1, -1, CAM_FILT_DAMAGE); // 1 tick of red damage
-	player_inventory.take_damage(damage_scale*fticks, poison_type); // take damage over time
+	player_inventory.take_damage(damage_scale*timestep, poison_type); // take damage over time
 
 	if (player_inventory.player_is_dead()) {
 		if (has_key) {*has_key |= player_has_room_key();}
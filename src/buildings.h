@@ -1065,7 +1065,9 @@ struct building_room_geom_t {
 	float obj_scale=1.0;
 	unsigned wall_ps_start=0, buttons_start=0, stairs_start=0, backrooms_start=0, retail_start=0; // index of first object of {TYPE_PG_*|TYPE_PSPACE, TYPE_BUTTON, TYPE_STAIR, retail}
 	unsigned init_num_doors=0, init_num_dstacks=0; // required for removing doors added by backrooms generation when room_geom is deleted
-	unsigned pool_ramp_obj_ix=0, pool_stairs_start_ix=0, last_animal_update_frame=0;
+	unsigned pool_ramp_obj_ix=0, pool_stairs_start_ix=0, last_animal_update_frame=0, animal_sim_step=0; // animal_sim_step seeds the per-step rgen
+	float animal_sim_time=0.0; // accumulated animal sim time not yet consumed by fixed steps, in ticks
+	double animal_sim_clock=0.0; // total animal sim time, in ticks; used for sleep and update deadlines in place of tfticks
 	point tex_origin;
 	colorRGBA wood_color;
 	courtyard_t courtyard;
@@ -2030,6 +2032,7 @@ struct building_t : public building_geom_t {
 	bool has_interior () const {return bool(interior);}
 	bool has_conn_info() const {return (interior && interior->conn_info);}
 	bool has_room_geom() const {return (has_interior() && interior->room_geom);}
+	float get_animal_sim_clock() const {return (has_room_geom() ? (float)interior->room_geom->animal_sim_clock : 0.0f);}
 	bool has_sec_bldg () const {return (has_garage || has_shed);}
 	bool has_pri_hall () const {return (hallway_dim <= 1);} // otherwise == 2 (Note: some callers check !pri_hall.is_all_zeros(); should they instead call this function?)
 	bool has_basement () const {return (basement_part_ix >= 0);}
@@ -2361,18 +2364,18 @@ private:
 public:
 	template<typename T> void add_animals_on_floor(T &animals, unsigned building_ix, unsigned num_min, unsigned num_max, float sz_min, float sz_max) const;
 	void update_animals      (point const &camera_bs, unsigned building_ix);
-	void update_rats         (point const &camera_bs, unsigned building_ix);
-	void update_sewer_rats   (point const &camera_bs, unsigned building_ix);
-	void update_pet_rats     (point const &camera_bs, unsigned building_ix);
-	void update_spiders      (point const &camera_bs, unsigned building_ix);
-	void update_sewer_spiders(point const &camera_bs, unsigned building_ix);
-	void update_snakes       (point const &camera_bs, unsigned building_ix);
+	void update_rats         (point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix);
+	void update_sewer_rats   (point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix);
+	void update_pet_rats     (point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix);
+	void update_spiders      (point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix);
+	void update_sewer_spiders(point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix);
+	void update_snakes       (point const &camera_bs, unsigned building_ix, float timestep, unsigned step_ix);
 	void update_pet_snakes   (point const &camera_bs, unsigned building_ix);
 	void update_pet_birds    (point const &camera_bs, unsigned building_ix);
 	void update_insects      (point const &camera_bs, unsigned building_ix);
 	void get_objs_at_or_below_ground_floor(vect_room_object_t &ret, bool for_spider) const;
 	bool begin_fish_draw() const;
-	void rat_bite_player(point const &pos, float damage, rand_gen_t &rgen);
+	void rat_bite_player(point const &pos, float damage, float timestep, rand_gen_t &rgen);
 private:
 	// animals
 	point gen_animal_floor_pos(float radius, bool place_in_attic, bool not_player_visible, bool pref_dark_room, bool not_by_ext_door, rand_gen_t &rgen) const;
@@ -3076,6 +3079,7 @@ bool in_building_gameplay_mode();
 bool player_in_windowless_building();
 bool player_cant_see_outside_building();
 bool player_take_damage(float damage_scale, bool scream=0, int poison_type=0, uint8_t *has_key=nullptr);
+bool player_take_damage_over_time(float damage_scale, float timestep, bool scream=0, int poison_type=0, uint8_t *has_key=nullptr);
 void apply_building_fall_damage(float delta_z);
 float get_bldg_player_height();
 float get_player_eye_height();
@@ -1059,11 +1059,15 @@ public:
 		plot_xy.gen_adj_plots(plots);
 		//cout << "tile_to_block_map: " << tile_to_block_map.size() << ", tile_blocks: " << tile_blocks.size() << endl;
 	}
-	void gen_parking_lots_and_place_objects(vector<car_t> &cars, bool have_cars, bool &have_plot_dividers) {
+	void gen_parking_lots_and_place_objects(vector<car_t> &cars, bool have_cars) {
 		city_obj_placer = city_obj_placer_t(); // clear; should be empty anyway, since city_obj_placer is not reused
 		city_obj_placer.set_plot_subdiv_sz(get_plot_subdiv_sz());
 		city_obj_placer.add_city_ug_elevator_entrances(uges); // Note: can clear ug_elev_entrances after this, but it's not needed
 		city_obj_placer.gen_parking_and_place_objects(plots, plot_colliders, cars, roads, isecs, bcube, plot_cuts, city_id, have_cars, is_residential, !streetlights.empty());
+	}
+	void create_city_obj_groups() {city_obj_placer.create_obj_groups();}
+
+	void finalize_parking_lots_and_objects(bool &have_plot_dividers) { // must be called after create_city_obj_groups()
 		add_tile_blocks(city_obj_placer.parking_lots, tile_to_block_map, TYPE_PARK_LOT); // need to do this later, after gen_tile_blocks()
 		add_tile_blocks(city_obj_placer.driveways,    tile_to_block_map, TYPE_DRIVEWAY);
 		city_obj_placer.remap_parking_lot_ixs(); // required after sorting parking_lots
@@ -2339,6 +2343,8 @@ public:
 		for (auto b = blockers.begin(); b != blockers.end(); ++b) {
 			if (!b->contains_cube(bcube1) && !b->contains_cube(bcube2)) {active_blockers.push_back(*b);}
 		}
+		blocker_grid_t blocker_grid; // accelerates the many blocker queries in find_route_between_points()
+		blocker_grid.init(active_blockers);
 		// try to extend all permutations of roads on the shared sides between cities
 		vector<road_endpoint_t> rpts1, rpts2;
 		get_all_conn_road_endpoints(rn1, bcube2, rpts1);
@@ -2348,7 +2354,7 @@ public:
 			for (auto r2 = rpts2.begin(); r2 != rpts2.end(); ++r2) {
 				cand.clear();
 				cand.start_dim = r1->dim;
-				cand.cost = crc.find_route_between_points(r1->pt, r2->pt, active_blockers, cand.pts, bcube1, bcube2, road_hwidth, r1->dim, r1->dir, r2->dim, r2->dir);
+				cand.cost = crc.find_route_between_points(r1->pt, r2->pt, blocker_grid, cand.pts, bcube1, bcube2, road_hwidth, r1->dim, r1->dir, r2->dim, r2->dir);
 				if (cand.cost > 0.0 && (best_cand.cost == 0.0 || cand.cost < best_cand.cost)) {best_cand = cand;} // update best_can if valid and a lower cost
 			} // for r2
 		} // for r1
@@ -2775,7 +2781,16 @@ public:
 		for (auto i = road_networks.begin(); i != road_networks.end(); ++i) {i->calc_ix_values(road_networks, global_rn, global_plot_id);}
 	}
 	void gen_parking_lots_and_place_objects(vector<car_t> &cars, bool have_cars) {
-		for (auto i = road_networks.begin(); i != road_networks.end(); ++i) {i->gen_parking_lots_and_place_objects(cars, have_cars, have_plot_dividers);}
+		{ // placement is serial, in city order, since it modifies buildings, shared tree placement state, and the list of cars
+			highres_timer_t timer("Place City Objects (serial)");
+			for (auto i = road_networks.begin(); i != road_networks.end(); ++i) {i->gen_parking_lots_and_place_objects(cars, have_cars);}
+		}
+		{ // object grouping is independent per city; cities don't overlap, so placement in one city doesn't depend on groups in another city
+			highres_timer_t timer("Create City Object Groups (parallel)");
+#pragma omp parallel for schedule(dynamic,1)
+			for (int i = 0; i < (int)road_networks.size(); ++i) {road_networks[i].create_city_obj_groups();}
+		}
+		for (auto i = road_networks.begin(); i != road_networks.end(); ++i) {i->finalize_parking_lots_and_objects(have_plot_dividers);}
 	}
 	void get_city_bcubes(vect_cube_t &bcubes) const {
 		for (auto r = road_networks.begin(); r != road_networks.end(); ++r) {bcubes.push_back(r->get_bcube());}
@@ -2007,6 +2007,11 @@ void city_obj_placer_t::gen_parking_and_place_objects(vector<road_plot_t> &plots
 	connect_power_to_buildings(plots);
 	if (have_cars && is_residential) {add_cars_to_driveways(cars, plots, plot_colliders, city_id, rgen);}
 	place_birds(city_bcube, rgen); // after placing other objects
+	if (add_parking_lots) {cout << "parking lots: " << parking_lots.size() << ", spaces: " << num_spaces << ", filled: " << filled_spaces << endl;}
+}
+
+// only modifies objects of this city, so may be called in parallel across cities
+void city_obj_placer_t::create_obj_groups() {
 	bench_groups   .create_groups(benches,   all_objs_bcube);
 	planter_groups .create_groups(planters,  all_objs_bcube);
 	trashcan_groups.create_groups(trashcans, all_objs_bcube);
@@ -2049,7 +2054,6 @@ void city_obj_placer_t::gen_parking_and_place_objects(vector<road_plot_t> &plots
 	bball_groups   .create_groups(bballs,    all_objs_bcube);
 	pfloat_groups  .create_groups(pfloats,   all_objs_bcube);
 	if (skyway.valid) {all_objs_bcube.assign_or_union_with_cube(skyway.bcube);}
-	if (add_parking_lots) {cout << "parking lots: " << parking_lots.size() << ", spaces: " << num_spaces << ", filled: " << filled_spaces << endl;}
 }
 
 void city_obj_placer_t::remap_parking_lot_ixs() {
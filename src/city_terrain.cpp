@@ -8,6 +8,54 @@ extern float water_plane_z;
 extern city_params_t city_params;
 
 
+// blocker_grid_t
+
+void blocker_grid_t::init(vect_cube_t const &blockers, unsigned max_grid_sz) {
+	cubes = blockers;
+	cells.clear();
+	nx = ny = 0;
+	if (cubes.empty()) return;
+	bcube = cubes.front();
+	for (cube_t const &c : cubes) {bcube.union_with_cube_xy(c);}
+	// choose a grid size with around one cube per cell, up to max_grid_sz cells per dim
+	unsigned const grid_sz(max(1U, min(max_grid_sz, unsigned(ceil(sqrt(float(cubes.size())))))));
+	nx = ((bcube.dx() > 0.0) ? grid_sz : 1);
+	ny = ((bcube.dy() > 0.0) ? grid_sz : 1);
+	cell_sz[0] = max(bcube.dx()/nx, TOLERANCE);
+	cell_sz[1] = max(bcube.dy()/ny, TOLERANCE);
+	cells.resize(nx*ny);
+
+	for (unsigned i = 0; i < cubes.size(); ++i) {
+		unsigned x1, y1, x2, y2;
+		get_cell_range(cubes[i], x1, y1, x2, y2);
+
+		for (unsigned y = y1; y <= y2; ++y) {
+			for (unsigned x = x1; x <= x2; ++x) {cells[y*nx + x].push_back(i);}
+		}
+	}
+}
+void blocker_grid_t::get_cell_range(cube_t const &c, unsigned &x1, unsigned &y1, unsigned &x2, unsigned &y2) const { // clamped to the grid
+	x1 = max(0, min(int(nx)-1, int(floor((c.x1() - bcube.x1())/cell_sz[0]))));
+	y1 = max(0, min(int(ny)-1, int(floor((c.y1() - bcube.y1())/cell_sz[1]))));
+	x2 = max(0, min(int(nx)-1, int(floor((c.x2() - bcube.x1())/cell_sz[0]))));
+	y2 = max(0, min(int(ny)-1, int(floor((c.y2() - bcube.y1())/cell_sz[1]))));
+}
+bool blocker_grid_t::has_int_xy_no_adj(cube_t const &c) const { // same as has_bcube_int_xy_no_adj(c, blockers)
+	if (cells.empty() || !c.intersects_xy(bcube)) return 0; // Note: all grid cubes are contained in bcube
+	unsigned x1, y1, x2, y2;
+	get_cell_range(c, x1, y1, x2, y2);
+
+	for (unsigned y = y1; y <= y2; ++y) {
+		for (unsigned x = x1; x <= x2; ++x) {
+			for (unsigned ix : cells[y*nx + x]) { // Note: cubes that span multiple cells may be tested more than once
+				if (cubes[ix].intersects_xy_no_adj(c)) return 1;
+			}
+		}
+	}
+	return 0;
+}
+
+
 // heightmap_query_t
 
 float smooth_interp(float a, float b, float mix) {
@@ -239,11 +287,11 @@ cube_t get_road_between_pts(point const &p1, point const &p2, float road_hwidth,
 	if (expand_end  ) {road.d[dim][ dir] += (dir ? 1.0 : -1.0)*road_hwidth;}
 	return road;
 }
-bool road_seg_valid(point const &p1, point const &p2, bool dim, vect_cube_t const &blockers, float road_hwidth, bool expand_start, bool expand_end) {
+bool road_seg_valid(point const &p1, point const &p2, bool dim, blocker_grid_t const &blockers, float road_hwidth, bool expand_start, bool expand_end) {
 	float const length(fabs(p1[dim] - p2[dim]));
 	if (length < 4.0*road_hwidth) return 0; // too short
 	if (fabs(p1.z - p2.z)/(length - road_hwidth) > city_params.max_road_slope) return 0; // check slope
-	return !has_bcube_int_xy_no_adj(get_road_between_pts(p1, p2, road_hwidth, expand_start, expand_end), blockers);
+	return !blockers.has_int_xy_no_adj(get_road_between_pts(p1, p2, road_hwidth, expand_start, expand_end));
 }
 bool check_pt_valid(point const &pt, cube_t const exclude[2]) {
 	return (pt.z > water_plane_z && !exclude[0].contains_pt_xy(pt) && !exclude[1].contains_pt_xy(pt));
@@ -275,7 +323,7 @@ float city_road_connector_t::calc_road_path_cost(vector<point> &pts) {
 	return cost;
 }
 
-float city_road_connector_t::find_route_between_points(point const &p1, point const &p2, vect_cube_t const &blockers, vector<point> &pts,
+float city_road_connector_t::find_route_between_points(point const &p1, point const &p2, blocker_grid_t const &blockers, vector<point> &pts,
 	cube_t const &bcube1, cube_t const &bcube2, float road_hwidth, bool dim1, bool dir1, bool dim2, bool dir2)
 {
 	float const min_extend(4.0*road_hwidth), min_jog(4.0*road_hwidth);
@@ -72,6 +72,19 @@ struct road_endpoint_t {
 	road_endpoint_t(point const &pt_, bool dim_, bool dir_) : pt(pt_), dim(dim_), dir(dir_) {}
 };
 
+class blocker_grid_t { // uniform XY grid of blocker cubes for fast overlap queries when routing connector roads
+	vect_cube_t cubes;
+	vector<vector<unsigned>> cells; // indices into cubes
+	cube_t bcube;
+	unsigned nx=0, ny=0;
+	float cell_sz[2] = {0.0, 0.0};
+
+	void get_cell_range(cube_t const &c, unsigned &x1, unsigned &y1, unsigned &x2, unsigned &y2) const;
+public:
+	void init(vect_cube_t const &blockers, unsigned max_grid_sz=64);
+	bool has_int_xy_no_adj(cube_t const &c) const;
+};
+
 struct road_cand_t {
 	vector<point> pts;
 	bool start_dim;
@@ -99,7 +112,7 @@ struct city_road_connector_t {
 	// roads
 	float calc_road_cost(point const &p1, point const &p2);
 	float calc_road_path_cost(vector<point> &pts);
-	float find_route_between_points(point const &p1, point const &p2, vect_cube_t const &blockers, vector<point> &pts,
+	float find_route_between_points(point const &p1, point const &p2, blocker_grid_t const &blockers, vector<point> &pts,
 		cube_t const &bcube1, cube_t const &bcube2, float road_hwidth, bool dim1, bool dir1, bool dim2, bool dir2);
 	bool segment_road(road_t const &road, bool check_only);
 	// transmission lines
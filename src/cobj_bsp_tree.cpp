@@ -436,14 +436,8 @@ bool cobj_bvh_tree::check_coll_line(point const &p1, point const &p2, point &cpo
 			// Note: we probably don't need to return cnorm and cpos in inexact mode, but it shouldn't be too expensive to do so
 			if ((int)cixs[i] == ignore_cobj) continue;
 			coll_obj const &c(get_cobj(i));
-			if (!obj_ok(c))                  continue;
-			if (skip_non_drawn  && !c.cp.might_be_drawn())                    continue;
-			if (skip_movable    && c.is_movable())                            continue;
-			if (test_alpha == 1 && c.is_semi_trans())                         continue; // semi-transparent, can see through
-			if (test_alpha == 2 && c.cp.color.alpha <= max_alpha)             continue; // lower alpha than an earlier object
-			if (test_alpha == 3 && c.cp.color.alpha < MIN_SHADOW_ALPHA)       continue; // less than min alpha
-			if (skip_init_colls && c.contains_pt(p1) && c.contains_point(p1)) continue;
-			if (!c.line_int_exact(p1, p2, t, cnorm, tmin, tmax))              continue;
+			if (skip_cobj_for_line(c, p1, test_alpha, max_alpha, skip_non_drawn, skip_init_colls, skip_movable)) continue;
+			if (!c.line_int_exact(p1, p2, t, cnorm, tmin, tmax)) continue;
 			cindex = cixs[i];
 			cpos   = p1 + (p2 - p1)*t;
 			//if (c.type == COLL_POLYGON && dot_product((p2 - p1), c.norm) < 0.0) {} // back-facing polygon test
@@ -459,6 +453,101 @@ bool cobj_bvh_tree::check_coll_line(point const &p1, point const &p2, point &cpo
 }
 
 
+unsigned const LINE_PACKET_SIZE = 32; // one bit per line in a packet mask
+
+inline unsigned spread_bits_3d(unsigned v) { // spread the low 10 bits of v so that there are two zero bits between each, for Morton codes
+	v = (v | (v << 16)) & 0x030000FF;
+	v = (v | (v <<  8)) & 0x0300F00F;
+	v = (v | (v <<  4)) & 0x030C30C3;
+	v = (v | (v <<  2)) & 0x09249249;
+	return v;
+}
+
+// any hit line queries, equivalent to calling check_coll_line() with exact=0 for each query, but with coherent lines grouped into packets
+// that traverse the tree together; returns the number of new hits
+unsigned cobj_bvh_tree::check_coll_lines(vector<coll_line_query_t> &queries, int ignore_cobj, int test_alpha,
+	bool skip_non_drawn, bool skip_init_colls, bool skip_movable) const
+{
+	assert(test_alpha != 2); // max alpha mode requires all intersections
+	if (nodes.empty() || queries.empty()) return 0;
+	cube_t const &bcube(nodes[0]);
+	vector3d const bsz(bcube.get_size()), scale(1023.0/max(bsz.x, TOLERANCE), 1023.0/max(bsz.y, TOLERANCE), 1023.0/max(bsz.z, TOLERANCE));
+	vector<pair<unsigned, unsigned>> order; // {sort key, query index}
+	order.reserve(queries.size());
+
+	for (unsigned i = 0; i < queries.size(); ++i) { // sort by direction octant, then by Morton code of the start point within the tree bcube
+		coll_line_query_t const &q(queries[i]);
+		if (q.has_coll()) continue; // already hit something, maybe in another tree
+		vector3d const dir(q.p2 - q.p1);
+		unsigned const octant((dir.x < 0.0) + 2*(dir.y < 0.0) + 4*(dir.z < 0.0)); // 3 bits
+		unsigned morton(0);
+
+		for (unsigned d = 0; d < 3; ++d) {
+			unsigned const v(max(0, min(1023, int((q.p1[d] - bcube.d[d][0])*scale[d]))));
+			morton |= (spread_bits_3d(v) << d); // 30 bits
+		}
+		order.emplace_back(((octant << 29) | (morton >> 1)), i);
+	}
+	sort(order.begin(), order.end());
+	vector<unsigned> qixs(order.size());
+	for (unsigned i = 0; i < order.size(); ++i) {qixs[i] = order[i].second;}
+	unsigned num_hits(0);
+
+	for (unsigned i = 0; i < qixs.size(); i += LINE_PACKET_SIZE) {
+		check_coll_lines_packet(queries, (qixs.data() + i), min(LINE_PACKET_SIZE, unsigned(qixs.size() - i)), ignore_cobj, test_alpha, skip_non_drawn, skip_init_colls, skip_movable);
+	}
+	for (unsigned i : qixs) {num_hits += queries[i].has_coll();}
+	return num_hits;
+}
+
+void cobj_bvh_tree::check_coll_lines_packet(vector<coll_line_query_t> &queries, unsigned const *qixs, unsigned num, int ignore_cobj,
+	int test_alpha, bool skip_non_drawn, bool skip_init_colls, bool skip_movable) const
+{
+	assert(num > 0 && num <= LINE_PACKET_SIZE);
+	vector<node_ix_mgr> nixms; // one per line, for the line clip function and inverse direction
+	nixms.reserve(num);
+	for (unsigned n = 0; n < num; ++n) {nixms.emplace_back(nodes, queries[qixs[n]].p1, queries[qixs[n]].p2);}
+	vector<pair<unsigned, uint32_t>> stack; // {end of subtree node index, mask of lines to restore at the end of the subtree}
+	uint32_t const all_mask((num == 32) ? 0xFFFFFFFF : ((1U << num) - 1));
+	uint32_t mask(all_mask), done(0);
+	unsigned const num_nodes((unsigned)nodes.size());
+	float t(0.0);
+	vector3d cnorm; // unused
+
+	for (unsigned nix = 0; nix < num_nodes && done != all_mask;) {
+		while (!stack.empty() && nix >= stack.back().first) {mask = (stack.back().second & ~done); stack.pop_back();}
+		tree_node const &n(nodes[nix]);
+		uint32_t hit_mask(0);
+
+		for (unsigned b = 0; b < num; ++b) {
+			if ((mask & (1U << b)) && nixms[b].get_line_clip_func(nixms[b].p1, nixms[b].dinv, n.d)) {hit_mask |= (1U << b);}
+		}
+		if (hit_mask == 0) { // all lines failed the bbox test
+			assert(n.next_node_id > nix);
+			nix = n.next_node_id;
+			continue;
+		}
+		if (hit_mask != mask) {stack.emplace_back(n.next_node_id, mask); mask = hit_mask;} // only a subset of lines enter this subtree
+		++nix;
+
+		for (unsigned i = n.start; i < n.end && mask; ++i) { // check leaves
+			if ((int)cixs[i] == ignore_cobj) continue;
+			coll_obj const &c(get_cobj(i));
+
+			for (unsigned b = 0; b < num; ++b) {
+				if (!(mask & (1U << b))) continue;
+				coll_line_query_t &q(queries[qixs[b]]);
+				if (skip_cobj_for_line(c, q.p1, test_alpha, 0.0, skip_non_drawn, skip_init_colls, skip_movable)) continue;
+				if (!c.line_int_exact(q.p1, q.p2, t, cnorm, 0.0, 1.0)) continue;
+				q.cindex = cixs[i]; // return first hit
+				done |= (1U << b);
+				mask &= ~(1U << b);
+			}
+		} // for i
+	} // for nix
+}
+
+
 bool cobj_bvh_tree::check_point_contained(point const &p, int &cindex) const {
 
 	unsigned const num_nodes((unsigned)nodes.size());
@@ -800,6 +889,24 @@ bool check_coll_line_tree(point const &p1, point const &p2, int &cindex, int ign
 	return 0;
 }
 
+// batched version of check_coll_line_tree(); queries that already have a cindex are skipped; returns the number of new hits
+unsigned check_coll_lines_tree(vector<coll_line_query_t> &queries, int ignore_cobj, bool dynamic,
+	int test_alpha, bool skip_non_drawn, bool include_voxels, bool skip_init_colls, bool skip_movable)
+{
+	unsigned num_hits(get_tree(dynamic).check_coll_lines(queries, ignore_cobj, test_alpha, skip_non_drawn, skip_init_colls, skip_movable));
+	if (!dynamic) {num_hits += cobj_tree_static_moving.check_coll_lines(queries, ignore_cobj, test_alpha, skip_non_drawn, skip_init_colls, skip_movable);}
+
+	if (!dynamic && include_voxels) {
+		vector3d cnorm; // unused
+		point cpos; // unused
+
+		for (coll_line_query_t &q : queries) {
+			if (!q.has_coll() && check_voxel_coll_line(q.p1, q.p2, cpos, cnorm, q.cindex, ignore_cobj, 0)) {++num_hits;}
+		}
+	}
+	return num_hits;
+}
+
 // used in destroy_cobj for cobj destroy/modification and connected/anchoring tests
 void get_intersecting_cobjs_tree(cube_t const &cube, vector<unsigned> &cobjs, int ignore_cobj, float toler,
 	bool dynamic, bool check_ccounter, int id_for_cobj_int)
@@ -134,6 +134,18 @@ class cobj_bvh_tree : public cobj_tree_base {
 			(!occluders_only || c.is_occluder()) && !(c.cp.flags & COBJ_NO_COLL) && (!cubes_only || c.type == COLL_CUBE) &&
 			(inc_voxel_cobjs || c.cp.cobj_type != COBJ_TYPE_VOX_TERRAIN));
 	}
+	bool skip_cobj_for_line(coll_obj const &c, point const &p1, int test_alpha, float max_alpha, bool skip_non_drawn, bool skip_init_colls, bool skip_movable) const {
+		if (!obj_ok(c))                                                   return 1;
+		if (skip_non_drawn  && !c.cp.might_be_drawn())                    return 1;
+		if (skip_movable    && c.is_movable())                            return 1;
+		if (test_alpha == 1 && c.is_semi_trans())                         return 1; // semi-transparent, can see through
+		if (test_alpha == 2 && c.cp.color.alpha <= max_alpha)             return 1; // lower alpha than an earlier object
+		if (test_alpha == 3 && c.cp.color.alpha < MIN_SHADOW_ALPHA)       return 1; // less than min alpha
+		if (skip_init_colls && c.contains_pt(p1) && c.contains_point(p1)) return 1;
+		return 0;
+	}
+	void check_coll_lines_packet(vector<coll_line_query_t> &queries, unsigned const *qixs, unsigned num, int ignore_cobj,
+		int test_alpha, bool skip_non_drawn, bool skip_init_colls, bool skip_movable) const;
 
 public:
 	cobj_bvh_tree(coll_obj_group const *cobjs_, bool s, bool d, bool o, bool c, bool v)
@@ -146,6 +158,7 @@ public:
 	void build_tree_from_cixs(bool do_mt_build);
 	bool check_coll_line(point const &p1, point const &p2, point &cpos, vector3d &cnorm, int &cindex, int ignore_cobj,
 		bool exact, int test_alpha, bool skip_non_drawn, bool skip_init_colls, bool skip_movable) const;
+	unsigned check_coll_lines(vector<coll_line_query_t> &queries, int ignore_cobj, int test_alpha, bool skip_non_drawn, bool skip_init_colls, bool skip_movable) const;
 	bool check_point_contained(point const &p, int &cindex) const;
 	void get_intersecting_cobjs(cube_t const &cube, vector<unsigned> &cobjs, int ignore_cobj, float toler, bool check_ccounter, int id_for_cobj_int) const;
 	bool is_cobj_contained(point const &viewer, point const *const pts, unsigned npts, int ignore_cobj, int &cobj) const;
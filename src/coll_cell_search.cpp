@@ -260,6 +260,15 @@ bool check_coll_line(point const &pos1, point const &pos2, int &cindex, int cobj
 	return 0;
 }
 
+// batched version of check_coll_line() for many independent lines; fills in cindex for queries that hit; returns the number of hits
+unsigned check_coll_lines(vector<coll_line_query_t> &queries, int cobj, int skip_dynamic, int test_alpha, bool include_voxels, bool skip_init_colls, bool skip_movable) {
+
+	if (world_mode != WMODE_GROUND) return 0;
+	unsigned num_hits(check_coll_lines_tree(queries, cobj, 0, test_alpha, (skip_dynamic >= 2), include_voxels, skip_init_colls, skip_movable)); // static cobjs + voxels
+	if (!skip_dynamic && begin_motion) {num_hits += check_coll_lines_tree(queries, cobj, 1, test_alpha, 0, 0, skip_init_colls, skip_movable);} // dynamic cobjs
+	return num_hits;
+}
+
 
 bool check_coll_line_exact(point pos1, point pos2, point &cpos, vector3d &cnorm, int &cindex, float splash_val, int ignore_cobj,
 	bool fast, bool test_alpha, bool skip_dynamic, bool include_voxels, bool skip_init_colls, bool no_stat_moving)
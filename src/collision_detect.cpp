@@ -1462,10 +1462,10 @@ void vert_coll_detector::check_cobj_intersect(int index, bool enable_cfs, bool p
 				if (otype.flags & OBJ_IS_DROP) {obj.velocity = zero_vector;}
 			}
 			if (type != DYNAM_PART && obj.velocity != zero_vector) {
-				assert(TIMESTEP > 0.0);
+				assert(step.timestep > 0.0);
 				float friction_adj(friction);
 				if (norm.z > 0.25 && (cobj.is_wet() || cobj.is_snow_cov())) {friction_adj *= 0.25;} // slippery when wet, icy, or snow covered
-				if (friction_adj > 0.0) {obj.velocity *= (1.0 - min(1.0f, (tstep/TIMESTEP)*friction_adj));} // apply kinetic friction
+				if (friction_adj > 0.0) {obj.velocity *= (1.0 - min(1.0f, (step.tstep/step.timestep)*friction_adj));} // apply kinetic friction
 				//for (unsigned i = 0; i < 3; ++i) {obj.velocity[i] *= (1.0 - fabs(norm[i]));} // norm must be normalized
 				orthogonalize_dir(obj.velocity, norm, obj.velocity, 0); // rolling friction model
 			}
@@ -1556,7 +1556,7 @@ void vert_coll_detector::check_cobj_intersect(int index, bool enable_cfs, bool p
 				gen_decal((decal_pos - norm*o_radius), sz, norm, blood_tid, index, color, 0, (blood_tid == BLOOD_SPLAT_TEX), 60*TICKS_PER_SECOND, 1.0, tex_range);
 			}
 		}
-		if (!(obj.flags & FROZEN_FLAG)) {deform_obj(obj, norm, v0);} // skip deformation of frozen chunks
+		if (!(obj.flags & FROZEN_FLAG)) {deform_obj(obj, norm, v0, step.tstep);} // skip deformation of frozen chunks
 	}
 	if (cnorm != NULL) *cnorm = norm;
 	obj.flags |= OBJ_COLLIDED;
@@ -1579,7 +1579,7 @@ void vert_coll_detector::init_reset_pos() {
 
 int vert_coll_detector::check_coll() {
 
-	pold -= obj.velocity*tstep;
+	pold -= obj.velocity*step.tstep;
 	assert(!is_nan(pold));
 	assert(type >= 0 && type < NUM_TOT_OBJS);
 	o_radius = obj.get_true_radius();
@@ -1602,11 +1602,12 @@ int vert_coll_detector::check_coll() {
 
 // 0 = no vert coll, 1 = X coll, 2 = Y coll, 3 = X + Y coll
 int dwobject::check_vert_collision(int obj_index, int do_coll_funcs, int iter, vector3d *cnorm,
-	vector3d const &mdir, bool skip_dynamic, bool only_drawn, int only_cobj, bool skip_movable)
+	vector3d const &mdir, bool skip_dynamic, bool only_drawn, int only_cobj, bool skip_movable, phys_step_t const *step)
 {
 	if (world_mode == WMODE_INF_TERRAIN) {
+		phys_step_t const cur_step(step ? *step : get_frame_phys_step());
 		bool const check_interior(type == CAMERA);
-		point const p_last(pos - velocity*tstep);
+		point const p_last(pos - velocity*cur_step.tstep);
 		float const o_radius(get_true_radius());
 		vector3d cnorm(plus_z);
 		
@@ -1618,7 +1619,7 @@ int dwobject::check_vert_collision(int obj_index, int do_coll_funcs, int iter, v
 			if (friction < STICK_THRESHOLD) {
 				if (otype.elasticity == 0.0 || (flags & IS_CUBE_FLAG) || !object_bounce(3, cnorm, 0.8, 0.0)) { // elasticity is hard-coded to 0.8 here
 					if (type != DYNAM_PART && velocity != zero_vector) {
-						if (friction > 0.0) {velocity *= (1.0 - min(1.0f, (tstep/TIMESTEP)*friction));} // apply kinetic friction
+						if (friction > 0.0) {velocity *= (1.0 - min(1.0f, (cur_step.tstep/cur_step.timestep)*friction));} // apply kinetic friction
 						orthogonalize_dir(velocity, cnorm, velocity, 0); // rolling friction model
 					}
 				}
@@ -1641,7 +1642,7 @@ int dwobject::check_vert_collision(int obj_index, int do_coll_funcs, int iter, v
 		return 0; // no vert coll
 	}
 	if (world_mode != WMODE_GROUND) return 0;
-	vert_coll_detector vcd(*this, obj_index, do_coll_funcs, iter, cnorm, mdir, skip_dynamic, only_drawn, only_cobj, skip_movable);
+	vert_coll_detector vcd(*this, obj_index, do_coll_funcs, iter, cnorm, mdir, skip_dynamic, only_drawn, only_cobj, skip_movable, step);
 	return vcd.check_coll();
 }
 
@@ -333,6 +333,7 @@ public:
 	vector<unsigned> &get_draw_stream(unsigned stream_id) {assert(stream_id < to_draw_streams.size()); return to_draw_streams[stream_id];}
 	vector<unsigned> &get_cur_draw_stream() {return get_draw_stream(cur_draw_stream_id);}
 	void set_cur_draw_stream_from_drawn_ids();
+	unsigned get_static_geom_hash() const;
 	vector<unsigned> &get_temp_cobjs() {temp_cobjs.clear(); return temp_cobjs;}
 	
 	coll_obj &get_cobj(int index) {
@@ -379,6 +380,16 @@ struct cobj_query_callback {
 };
 
 
+struct coll_line_query_t { // for batched line of sight queries; queries that already have a cindex are skipped
+	point p1, p2;
+	int cindex=-1; // output: the first cobj found to intersect the line, not necessarily the closest
+
+	coll_line_query_t() {}
+	coll_line_query_t(point const &p1_, point const &p2_) : p1(p1_), p2(p2_) {}
+	bool has_coll() const {return (cindex >= 0);}
+};
+
+
 struct polygon_t : public vector<vert_norm_tc> {
 	polygon_t() {}
 	polygon_t(vector<vert_norm_tc> const &vv) : vector<vert_norm_tc>(vv) {}
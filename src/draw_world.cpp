@@ -1504,15 +1504,14 @@ void draw_part_clouds(vector<particle_cloud> const &pc, int tid) {
 
 void physics_particle_manager::draw(float radius, int tid, bool emissive) const {
 
-	if (parts.empty()) return;
+	if (empty()) return;
 	point const camera(get_camera_pos());
 	enable_blend();
 	point_sprite_drawer_norm_sized psd;
-	psd.reserve_pts(parts.size());
+	psd.reserve_pts(size());
 
-	for (unsigned i = 0; i < parts.size(); ++i) {
-		//psd.add_pt(vert_norm_color(parts[i].p, (camera - parts[i].p).get_norm(), parts[i].c.c), radius); // normal faces camera
-		psd.add_pt(sized_vert_t<vert_norm_color>(vert_norm_color(parts[i].p, (camera - parts[i].p).get_norm(), parts[i].c.c), radius)); // normal faces camera
+	for (unsigned i = 0; i < size(); ++i) {
+		psd.add_pt(sized_vert_t<vert_norm_color>(vert_norm_color(ppos[i], (camera - ppos[i]).get_norm(), colors[i].c), radius)); // normal faces camera
 	}
 	if (tid >= 0) {psd.sort_back_to_front();} // if we have an alpha texture, sort back to front
 	psd.draw(tid, 0.0, !emissive); // draw with lighting
@@ -1775,8 +1774,11 @@ void add_camera_filter(colorRGBA const &color, unsigned time, int tid, unsigned
 	
 	assert(ix < MAX_CFILTERS);
 	if (color.alpha == 0.0) return;
-	if (cfilters.size() <= ix) cfilters.resize(ix+1);
-	cfilters[ix] = camera_filter(color, time, tid, fades);
+#pragma omp critical(add_camera_filter) // universe mode adds filters from both the ship and drawing threads
+	{
+		if (cfilters.size() <= ix) cfilters.resize(ix+1);
+		cfilters[ix] = camera_filter(color, time, tid, fades);
+	}
 }
 
 
@@ -462,6 +462,8 @@ bool check_coll_line_exact_tree(point const &p1, point const &p2, point &cpos, v
 	bool dynamic=0, int test_alpha=0, bool skip_non_drawn=0, bool include_voxels=1, bool skip_init_colls=0, bool skip_movable=0, bool no_stat_moving=0);
 bool check_coll_line_tree(point const &p1, point const &p2, int &cindex, int ignore_cobj, bool dynamic=0, int test_alpha=0,
 	bool skip_non_drawn=0, bool include_voxels=1, bool skip_init_colls=0, bool skip_movable=0);
+unsigned check_coll_lines_tree(vector<coll_line_query_t> &queries, int ignore_cobj, bool dynamic=0, int test_alpha=0,
+	bool skip_non_drawn=0, bool include_voxels=1, bool skip_init_colls=0, bool skip_movable=0);
 bool cobj_contained_tree(point const &viewer, point const *const pts, unsigned npts, int ignore_cobj, int &cobj);
 void get_coll_line_cobjs_tree(point const &pos1, point const &pos2, int ignore_cobj,
 	vector<int> *cobjs, cobj_query_callback *cqc, bool dynamic, bool occlude, bool do_expand);
@@ -472,6 +474,8 @@ void get_intersecting_cobjs_tree(cube_t const &cube, vector<unsigned> &cobjs, in
 	bool dynamic, bool check_ccounter, int id_for_cobj_int=-1);
 bool check_coll_line(point const &pos1, point const &pos2, int &cindex, int c_obj, int skip_dynamic, int test_alpha,
 	bool include_voxels=1, bool skip_init_colls=0, bool skip_movable=0);
+unsigned check_coll_lines(vector<coll_line_query_t> &queries, int c_obj, int skip_dynamic, int test_alpha,
+	bool include_voxels=1, bool skip_init_colls=0, bool skip_movable=0);
 bool check_coll_line_exact(point pos1, point pos2, point &cpos, vector3d &coll_norm, int &cindex, float splash_val=0.0, int ignore_cobj=-1,
 	bool fast=0, bool test_alpha=0, bool skip_dynamic=0, bool include_voxels=1, bool skip_init_colls=0, bool no_stat_moving=0);
 bool cobj_contained_ref(point const &pos1, const point *pts, unsigned npts, int cobj, int &last_cobj);
@@ -970,7 +974,7 @@ void fgPerspective(float fov_y, float aspect, float near_clip, float far_clip);
 void fgOrtho(float left, float right, float bottom, float top, float zNear, float zFar);
 void fgLookAt(float eyex, float eyey, float eyez, float centerx, float centery, float centerz, float upx, float upy, float upz);
 void fgMultMatrix(xform_matrix const &m);
-void deform_obj(dwobject &obj, vector3d const &norm, vector3d const &v0);
+void deform_obj(dwobject &obj, vector3d const &norm, vector3d const &v0, float step_tstep);
 void update_deformation(dwobject &obj);
 
 // function prototypes - draw_text
@@ -2775,6 +2775,9 @@ class building_creator_t {
 		cube_t const &get_vis_bcube() const {return ((player_in_ext_basement() || player_in_uge) ? extb_bcube : ext_vis_bcube);}
 	};
 	vector<grid_elem_t> grid, grid_by_tile;
+	// per grid element: buildings whose extended basement overlaps it; built after the ext basement join pass, and empty before that
+	vector<vector<unsigned>> extb_grid;
+	cube_t extb_range; // union of all extended basement bcubes, which may extend outside range
 
 	grid_elem_t &get_grid_elem(unsigned gx, unsigned gy) {
 		assert(gx < grid_sz && gy < grid_sz && !grid.empty());
@@ -2812,6 +2815,24 @@ class building_creator_t {
 			if (expand_by_one && ixr[1][d]+1 < grid_sz) {++ixr[1][d];}
 		}
 	}
+	void build_extb_grid() {
+		extb_grid.clear();
+		extb_range.set_to_zeros();
+
+		for (unsigned bix = 0; bix < buildings.size(); ++bix) {
+			building_t const &b(buildings[bix]);
+			if (b.bcube.is_all_zeros() || !b.has_ext_basement()) continue;
+			if (extb_grid.empty()) {extb_grid.resize(grid.size());}
+			cube_t const &extb_bcube(b.interior->basement_ext_bcube);
+			extb_range.assign_or_union_with_cube(extb_bcube);
+			unsigned ixr[2][2];
+			get_grid_range(extb_bcube, ixr); // clamped to range
+
+			for (unsigned y = ixr[0][1]; y <= ixr[1][1]; ++y) {
+				for (unsigned x = ixr[0][0]; x <= ixr[1][0]; ++x) {extb_grid[y*grid_sz + x].push_back(bix);}
+			}
+		} // for bix
+	}
 	void add_to_grid(cube_t const &bcube, unsigned bix, bool is_road_seg) {
 		unsigned ixr[2][2];
 		get_grid_range(bcube, ixr);
@@ -2926,6 +2947,7 @@ public:
 		buildings.clear();
 		grid.clear();
 		grid_by_tile.clear();
+		extb_grid.clear();
 		bix_by_plot.clear();
 		clear_vbos();
 		buildings_bcube = cube_t();
@@ -3308,6 +3330,7 @@ public:
 				b->has_tline_conn = connect_to_nearest_transmission_line(bldg_conn_pt, tline_dist, tline_conn_pt);
 			}
 		} // for b
+		build_extb_grid(); // must be after the ext basement join pass, which can grow basement_ext_bcube
 		if (!is_tile && (!city_only || maybe_residential)) {place_building_trees(rgen);}
 
 		if (!is_tile) {
@@ -4475,18 +4498,27 @@ public:
 	}
 	// used for extended basement intersection checks; Note: bcube is in local building space
 	bool check_cube_coll(cube_t const &bcube, bool xy_only, bool inc_basement, building_t const *exclude1, building_t const *exclude2) const {
-		if (empty() || !range.intersects_xy(bcube)) return 0; // no buildings, or outside buildings bcube
+		bool const use_extb_grid(inc_basement && !extb_grid.empty()); // extended basements are indexed by every grid element they overlap
+		if (empty() || !(range.intersects_xy(bcube) || (use_extb_grid && extb_range.intersects_xy(bcube)))) return 0; // no buildings, or outside buildings bcube
 		unsigned ixr[2][2];
 		// buildings can extend outside grid bcubes, so we need to look in adjacent grids;
 		// note that buildings are actually added to each grid they overlap, but that's their bcube only, and doesn't include their extended basement (which is added later);
 		// extended basements are limited to the grid containing the building's center, but the grid bcube can extend outside the grid itself
-		// due to other buildings that extend off the grid, even if the current building is completely contained and isn't itself in the adjacent grid
-		bool const expand_by_one(inc_basement); // example: (-1.12, -15.7)
+		// due to other buildings that extend off the grid, even if the current building is completely contained and isn't itself in the adjacent grid;
+		// this is only needed while buildings are being generated, before the extended basement grid has been built
+		bool const expand_by_one(inc_basement && !use_extb_grid); // example: (-1.12, -15.7)
 		get_grid_range(bcube, ixr, expand_by_one);
 
 		// Note: can't check driveways/road_segs because they may not have been created yet
 		for (unsigned y = ixr[0][1]; y <= ixr[1][1]; ++y) {
 			for (unsigned x = ixr[0][0]; x <= ixr[1][0]; ++x) {
+				if (use_extb_grid) {
+					for (unsigned bix : extb_grid[y*grid_sz + x]) {
+						building_t const &building(get_building(bix));
+						if (&building == exclude1 || &building == exclude2) continue;
+						if (building.cube_intersects_extb_room(bcube)) return 1; // extended basement intersection
+					}
+				}
 				grid_elem_t const &ge(get_grid_elem(x, y));
 				if (ge.empty()) continue; // skip empty grid
 				if (!bcube.intersects_xy(ge.bcube)) continue; // Note: no need to check z-range
@@ -4494,7 +4526,7 @@ public:
 				for (auto b = ge.bc_ixs.begin(); b != ge.bc_ixs.end(); ++b) {
 					building_t const &building(get_building(b->ix));
 					if (&building == exclude1 || &building == exclude2) continue;
-					if (inc_basement && building.cube_intersects_extb_room(bcube)) return 1; // extended basement intersection
+					if (inc_basement && !use_extb_grid && building.cube_intersects_extb_room(bcube)) return 1; // extended basement intersection
 					if (!bcube.intersects_xy(*b)) continue; // no intersection
 						
 					if (!xy_only) {
@@ -340,15 +340,15 @@ void physics_particle_manager::gen_particles(point const &pos, vector3d const &v
 
 	if (!is_pos_valid(pos)) return; // origin invalid
 	unsigned const MAX_PARTS = 100000; // limit of 100K particles
-	if (parts.size() >= MAX_PARTS) return; // too may particles
-	num = min(num, unsigned(parts.size() - MAX_PARTS));
+	if (size() >= MAX_PARTS) return; // too may particles
+	num = min(num, unsigned(MAX_PARTS - size()));
 
 	for (unsigned i = 0; i < num; ++i) {
-		point ppos;
-		do {ppos = pos + signed_rand_vector_spherical(gen_radius);} while (!is_pos_valid(ppos)); // find a valid particle starting pos
+		point part_pos;
+		do {part_pos = pos + signed_rand_vector_spherical(gen_radius);} while (!is_pos_valid(part_pos)); // find a valid particle starting pos
 		vector3d pvel(vadd + signed_rand_vector_spherical(vmag));
 		if (pvel.z < 0.0) {pvel.z *= -1.0;} // make sure it's going up
-		parts.push_back(part_t(ppos, pvel, color));
+		add_particle(part_pos, pvel, color);
 	}
 }
 
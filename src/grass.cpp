@@ -54,9 +54,8 @@ void detail_scenery_t::setup_shaders_post(shader_t &s) { // used for grass and f
 void grass_manager_t::grass_t::merge(grass_t const &g) {
 
 	p   = (p + g.p)*0.5; // average locations
-	float const dmag1(dir.mag()), dmag2(g.dir.mag());
-	dir = (dir/dmag1 + g.dir/dmag2).get_norm() * (0.5f*(dmag1 + dmag2)); // average directions and lengths independently
-	n   = (n + g.n).get_norm(); // average normals
+	set_dir((dir_nc.get_norm() + g.dir_nc.get_norm()).get_norm() * (0.5f*(len + g.len))); // average directions and lengths independently
+	n.set_norm((get_norm() + g.get_norm()).get_norm()); // average normals
 	w  += g.w; // add widths to preserve surface area
 	//UNROLL_3X(c[i_] = (unsigned char)(unsigned(c[i_]) + unsigned(g.c[i_]))/2;) // don't average colors because they're used for the density filtering hash
 }
@@ -109,8 +108,9 @@ void grass_manager_t::create_new_vbo() {
 
 void grass_manager_t::add_to_vbo_data(grass_t const &g, vector<grass_data_t> &data, unsigned &ix, vector3d const &norm) const {
 
-	point p2(g.p + g.dir); p2.z += 0.05*grass_length;
-	vector3d const binorm(cross_product(g.dir, g.n));
+	vector3d const dir(g.get_dir());
+	point p2(g.p + dir); p2.z += 0.05*grass_length;
+	vector3d const binorm(cross_product(dir, g.get_norm()));
 	vector3d const delta(binorm*(0.5*g.w/binorm.mag()));
 	norm_comp const nc(norm);
 	assert(ix+2 < data.size());
@@ -122,7 +122,7 @@ void grass_manager_t::add_to_vbo_data(grass_t const &g, vector<grass_data_t> &da
 void grass_manager_t::scale_grass(float lscale, float wscale) {
 
 	for (auto i = grass.begin(); i != grass.end(); ++i) {
-		i->dir *= lscale;
+		i->len *= lscale;
 		i->w   *= wscale;
 	}
 	clear_vbo();
@@ -267,6 +267,78 @@ unsigned grass_tile_manager_t::render_block(unsigned block_ix, unsigned lod, flo
 }
 
 
+// per-mesh-vertex count of random upward rays that hit static cobjs, used to thin out grass under objects;
+// expensive to compute, so it's reused across grass regeneration until the mesh or static cobjs change
+class sky_occlusion_grid_t {
+
+	unsigned stride=0, samples=0, scene_key=0;
+	vector<unsigned char> occ_cnt;
+
+	static unsigned calc_scene_key(unsigned num_samples) {
+		unsigned hv(num_samples);
+		hash_mix_point(point(get_xval(0), get_yval(0), Z_SCENE_SIZE), hv);
+		hash_mix_point(point(MESH_X_SIZE, MESH_Y_SIZE, DX_VAL), hv);
+
+		for (int y = 0; y <= MESH_Y_SIZE; ++y) { // same ray start points as calc()
+			for (int x = 0; x <= MESH_X_SIZE; ++x) {
+				hash_mix_point(point(mesh_height[min(y, MESH_Y_SIZE-1)][min(x, MESH_X_SIZE-1)], is_mesh_disabled(x, y), 0.0), hv);
+			}
+		}
+		hv += coll_objects.get_static_geom_hash(); // only static cobjs are in the tree used for occlusion
+		return hv;
+	}
+	void calc(unsigned num_samples) {
+		//RESET_TIME;
+		stride  = MESH_X_SIZE+1;
+		samples = num_samples;
+		occ_cnt.clear();
+		occ_cnt.resize(stride*(MESH_Y_SIZE+1), 0);
+		assert(samples <= 255); // counts must fit in an unsigned char
+
+#pragma omp parallel for schedule(dynamic,1)
+		for (int y = 0; y <= MESH_Y_SIZE; ++y) {
+			rand_gen_t occ_rgen;
+			occ_rgen.set_state(845631*y, 667239);
+			vector<coll_line_query_t> queries; // all lines for this row, tested as a batch
+			vector<unsigned> query_xs;
+
+			for (int x = 0; x <= MESH_X_SIZE; ++x) {
+				if (is_mesh_disabled(x, y)) continue;
+				point const start_pt(get_xval(x), get_yval(y), mesh_height[min(y, MESH_Y_SIZE-1)][min(x, MESH_X_SIZE-1)]);
+
+				for (unsigned n = 0; n < samples; ++n) {
+					point const end_pt(start_pt + Z_SCENE_SIZE*vector3d(0.5*occ_rgen.signed_rand_float(), 0.5*occ_rgen.signed_rand_float(), 1.0));
+					queries.emplace_back(start_pt, end_pt);
+					query_xs.push_back(x);
+				}
+			}
+			check_coll_lines(queries, -1, 1, 0, 0); // ignore alpha value (even for leaves, to incrase their influence)
+
+			for (unsigned i = 0; i < queries.size(); ++i) {
+				if (queries[i].has_coll()) {++occ_cnt[y*stride + query_xs[i]];}
+			}
+		}
+		//PRINT_TIME("Grass Occlusion");
+	}
+public:
+	void clear() {occ_cnt.clear(); stride = samples = scene_key = 0;}
+	unsigned get_num_samples() const {return samples;}
+
+	void update(unsigned num_samples) { // recompute only if the inputs have changed
+		unsigned const key(calc_scene_key(num_samples));
+		if (!occ_cnt.empty() && num_samples == samples && key == scene_key) return; // still valid
+		calc(num_samples);
+		scene_key = key;
+	}
+	unsigned get_quad_count(int x, int y) const { // sum over the 4 corners of mesh quad (x,y)
+		assert(!occ_cnt.empty());
+		return (occ_cnt[y*stride + x] + occ_cnt[y*stride + x+1] + occ_cnt[(y+1)*stride + x] + occ_cnt[(y+1)*stride + x+1]);
+	}
+};
+
+sky_occlusion_grid_t sky_occlusion_grid;
+
+
 class grass_manager_dynamic_t : public grass_manager_t {
 	
 	vector<unsigned> mesh_to_grass_map; // maps mesh x,y index to starting index in grass vector
@@ -303,32 +375,9 @@ public:
 		rgen.pregen_floats(10000);
 		unsigned num_voxel_polys(0), num_voxel_blades(0);
 		bool const grass_tex_enabled(default_ground_tex < 0 || default_ground_tex == GROUND_TEX);
-		unsigned const om_stride(MESH_X_SIZE+1);
-		vector<unsigned char> occ_map;
 		unsigned const SAMPLES_PER_TILE(min(grass_density, 16U));
-
-		if (grass_tex_enabled) {
-			occ_map.resize(om_stride*(MESH_Y_SIZE+1), 0);
-		
-#pragma omp parallel for schedule(dynamic,1)
-			for (int y = 0; y <= MESH_Y_SIZE; ++y) {
-				rand_gen_t occ_rgen;
-				occ_rgen.set_state(845631*y, 667239);
-
-				for (int x = 0; x <= MESH_X_SIZE; ++x) {
-					if (is_mesh_disabled(x, y)) continue;
-					point const start_pt(get_xval(x), get_yval(y), mesh_height[min(y, MESH_Y_SIZE-1)][min(x, MESH_X_SIZE-1)]);
-					unsigned char &val(occ_map[y*om_stride + x]);
-
-					for (unsigned n = 0; n < SAMPLES_PER_TILE; ++n) {
-						point const end_pt(start_pt + Z_SCENE_SIZE*vector3d(0.5*occ_rgen.signed_rand_float(), 0.5*occ_rgen.signed_rand_float(), 1.0));
-						int cindex(-1);
-						if (check_coll_line(start_pt, end_pt, cindex, -1, 1, 0, 0)) {++val;} // ignore alpha value (even for leaves, to incrase their influence)
-					}
-				}
-			}
-			//PRINT_TIME("Grass Occlusion");
-		}
+		bool const use_occlusion(grass_tex_enabled && SAMPLES_PER_TILE > 0);
+		if (use_occlusion) {sky_occlusion_grid.update(SAMPLES_PER_TILE);}
 		vector<vector<unsigned>> mesh_to_grass_local(MESH_Y_SIZE); // one per Y row
 		vector<vector<grass_t>> grass_local(MESH_Y_SIZE); // one per Y row
 		float const rscale_x(DX_VAL/2147483562.0), rscale_y(DY_VAL/2147483562.0);
@@ -392,9 +441,8 @@ public:
 				assert(vnz > 0.0);
 				float mod_den(grass_density/vnz); // slightly more grass on steep slopes so that we have equal density over the surface, not just the XY projection
 				
-				if (!occ_map.empty()) { // check 4 corners of occlusion map
-					unsigned const occ_cnt(occ_map[y*om_stride + x] + occ_map[y*om_stride + x+1] + occ_map[(y+1)*om_stride + x] + occ_map[(y+1)*om_stride + x+1]);
-					float const sunlight(1.0 - occ_cnt/(4.0*SAMPLES_PER_TILE));
+				if (use_occlusion) { // check 4 corners of occlusion map
+					float const sunlight(1.0 - sky_occlusion_grid.get_quad_count(x, y)/(4.0*SAMPLES_PER_TILE));
 					mod_den *= min(1.0f, 2.0f*sunlight); // more than half occluded reduces grass density
 				}
 				unsigned const tile_density(round_fp(mod_den));
@@ -509,8 +557,8 @@ public:
 
 				for (unsigned i = start; i < end; ++i) {
 					if (p2p_dist_xy_sq(pos, grass[i].p) > rad_sq) continue; // too far away
-					if (grass[i].dir == zero_vector) continue; // removed
-					pos.z = max(pos.z, (grass[i].p.z + grass[i].dir.z + radius));
+					if (grass[i].is_removed()) continue; // removed
+					pos.z = max(pos.z, (grass[i].p.z + grass[i].get_dir().z + radius));
 					return 1; // early terminate at first grass blade
 				}
 			}
@@ -538,7 +586,7 @@ public:
 
 		for (unsigned i = start; i < end; ++i) { // will do nothing if there's no grass here
 			grass_t &g(grass[i]);
-			if (!g.on_mesh || g.dir == zero_vector) continue; // not on mesh, or already "removed"
+			if (!g.on_mesh || g.is_removed()) continue; // not on mesh, or already "removed"
 			float const mh(interpolate_mesh_zval(g.p.x, g.p.y, 0.0, 0, 1));
 
 			if (fabs(g.p.z - mh) > 0.01*grass_width) { // is there any way we can check the ground texture to see if we sill have grass texture here?
@@ -576,29 +624,28 @@ public:
 					grass_t &g(grass[i]);
 					float const dsq(p2p_dist_xy_sq(pos, g.p));
 					if (dsq > rad_sq) continue; // too far away
-					if (g.dir == zero_vector) continue; // already "removed" (uncommon case)
+					if (g.is_removed()) continue; // already "removed" (uncommon case)
 					bool const underwater(maybe_underwater && g.on_mesh);
 					bool updated(0);
 
 					if (cut) {
-						float const length(g.dir.mag());
-
-						if (length > 0.25*grass_length) {
-							g.dir  *= sqrt(dsq)*rad_inv;
+						if (g.len > 0.25*grass_length) {
+							g.len  *= sqrt(dsq)*rad_inv;
 							updated = 1;
 						}
 					}
 					if (crush) {
 						vector3d const &sn(surface_normals[y][x]);
-						float const length(g.dir.mag());
+						vector3d const dir(g.get_dir());
+						float const length(g.len);
 
-						if (fabs(dot_product(g.dir, sn)) > 0.1*length) { // update if not flat against the mesh
+						if (fabs(dot_product(dir, sn)) > 0.1*length) { // update if not flat against the mesh
 							float const om_reld(1.0f - sqrt(dsq)*rad_inv), dx(g.p.x - pos.x), dy(g.p.y - pos.y), atten_val(1.0f - om_reld*om_reld);
 							vector3d const new_dir(vector3d(dx, dy, -(sn.x*dx + sn.y*dy)/sn.z).get_norm()); // point away from crushing point
 
-							if (dot_product(g.dir, new_dir) < 0.95*length) { // update if not already aligned
-								g.dir   = (g.dir*(atten_val/length) + new_dir*(1.0 - atten_val)).get_norm()*length;
-								g.n     = (g.n*atten_val + sn*(1.0 - atten_val)).get_norm();
+							if (dot_product(dir, new_dir) < 0.95*length) { // update if not already aligned
+								g.set_dir((dir*(atten_val/length) + new_dir*(1.0 - atten_val)).get_norm()*length);
+								g.n.set_norm((g.get_norm()*atten_val + sn*(1.0 - atten_val)).get_norm());
 								updated = 1;
 							}
 						}
@@ -616,14 +663,14 @@ public:
 						UNROLL_3X(updated |= (g.c[i_] > 0);)
 						if (updated) {UNROLL_3X(g.c[i_] = (unsigned char)(atten_val*g.c[i_]);)}
 					}
-					if (check_uw && underwater && (g.p.z + g.dir.mag()) <= water_matrix[y][x]) {
+					if (check_uw && underwater && (g.p.z + g.len) <= water_matrix[y][x]) {
 						unsigned char uwc[3] = {120,  100, 50};
 						UNROLL_3X(updated |= (g.c[i_] != uwc[i_]);)
 						if (updated) {UNROLL_3X(g.c[i_] = (unsigned char)(0.9*g.c[i_] + 0.1*uwc[i_]);)}
 					}
 					if (remove) {
 						// Note: if we're removing, it doesn't make sense to do any other operations since they won't have any effect
-						g.dir   = zero_vector; // make zero length (can't actually remove it)
+						g.len   = 0.0; // make zero length (can't actually remove it)
 						updated = 1;
 					}
 					if (updated) {
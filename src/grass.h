@@ -20,16 +20,20 @@ struct detail_scenery_t : public vbo_wrap_t {
 class grass_manager_t : public detail_scenery_t {
 
 protected:
-	struct grass_t { // size = 44
+	struct grass_t { // size = 32 (was 44 with uncompressed dir and normal)
 		point p;
-		vector3d dir, n;
+		float len, w; // length of dir, width
+		norm_comp dir_nc, n; // compressed unit direction and normal
 		unsigned char c[3] = {};
 		unsigned char on_mesh : 1;
-		float w;
 
-		grass_t() : on_mesh(0), w(0.0) {}
+		grass_t() : len(0.0), w(0.0), on_mesh(0) {}
 		grass_t(point const &p_, vector3d const &dir_, vector3d const &n_, unsigned char const *const c_, float w_, bool on_mesh_)
-			: p(p_), dir(dir_), n(n_), on_mesh(on_mesh_), w(w_) {c[0] = c_[0]; c[1] = c_[1]; c[2] = c_[2];}
+			: p(p_), w(w_), n(n_), on_mesh(on_mesh_) {set_dir(dir_); c[0] = c_[0]; c[1] = c_[1]; c[2] = c_[2];}
+		vector3d get_dir() const {return ((len == 0.0) ? zero_vector : dir_nc.get_norm().get_norm()*len);} // renormalize to remove quantization error in length
+		vector3d get_norm() const {return n.get_norm();}
+		void set_dir(vector3d const &dir) {len = dir.mag(); dir_nc.set_norm((len == 0.0) ? zero_vector : dir/len);}
+		bool is_removed() const {return (len == 0.0);}
 		void merge(grass_t const &g);
 	};
 
@@ -8,6 +8,7 @@
 #include "file_utils.h"
 #include "sinf.h"
 #include "mesh.h"
+#include <sys/stat.h> // for fstat()
 
 using namespace std;
 
@@ -18,8 +19,10 @@ unsigned const TEX_EDGE_MODE = 2; // 0 = clamp, 1 = cliff/underwater, 2 = mirror
 extern unsigned hmap_filter_width, erosion_iters_tt;
 extern int display_mode;
 extern float mesh_scale, dxdy;
-extern string hmap_out_fn;
+extern float erode_amount, water_plane_z;
+extern string hmap_out_fn, hmap_cache_fn;
 
+FILE *open_texture_file_no_check(string const &filename);
 void get_heightmap_z_range(vector<float> const &heights, float &min_z, float &max_z);
 void set_mesh_height_scales_for_zval_range(float min_z, float dz);
 
@@ -33,28 +36,82 @@ void adjust_brush_weight(float &delta, float dval, int shape) {
 }
 
 //enum {BSHAPE_CONST_SQ=0, BSHAPE_CNST_CIR, BSHAPE_LINEAR, BSHAPE_QUADRATIC, BSHAPE_COSINE, BSHAPE_SINE, BSHAPE_FLAT_SQ, BSHAPE_FLAT_CIR, NUM_BSHAPES};
+void tex_mod_map_manager_t::brush_weights_t::calc(hmap_brush_t const &b, int step_sz_, unsigned num_steps_) {
+
+	assert(step_sz_ > 0 && num_steps_ > 0);
+	radius = b.radius; shape = b.shape; step_sz = step_sz_; num_steps = num_steps_;
+	num_x  = 2*radius/step_sz + 1; // same number of samples in x and y
+	unsigned const row_len(get_row_len()), num_rows(num_x*num_steps);
+	float const step_delta(1.0/num_steps), r_inv(1.0/max(1U, radius));
+	bool const is_round(shape != BSHAPE_CONST_SQ && shape != BSHAPE_FLAT_SQ);
+	weights.resize(row_len*num_rows);
+	x_spans.resize(num_rows);
+
+#pragma omp parallel for schedule(static,16) if (num_rows >= 256)
+	for (int r = 0; r < (int)num_rows; ++r) {
+		float const fy(float(int(r/num_steps)*step_sz - (int)radius) + (r%num_steps)*step_delta); // same as (yp + dy - y)
+		float *const row(weights.data() + r*row_len);
+		pair<int, int> &span(x_spans[r]);
+		span = make_pair(int(num_x), -1); // starts empty
+
+		for (unsigned ix = 0; ix < num_x; ++ix) {
+			for (unsigned sx = 0; sx < num_steps; ++sx) {
+				float const fx(float(int(ix*step_sz) - (int)radius) + sx*step_delta), dval(sqrt(fy*fy + fx*fx)*r_inv);
+				float &w(row[ix*num_steps + sx]);
+				if (is_round && dval > 1.0) {w = -1.0; continue;} // round (instead of square)
+				w = 1.0;
+				adjust_brush_weight(w, dval, shape);
+				min_eq(span.first, int(ix));
+				max_eq(span.second, int(ix));
+			} // for sx
+		} // for ix
+	} // for r
+}
+
 void tex_mod_map_manager_t::hmap_brush_t::apply(tex_mod_map_manager_t *tmmm, int step_sz, unsigned num_steps) const {
 
+	assert(tmmm);
 	assert(num_steps > 0);
-	float const step_delta(1.0/num_steps), r_inv(1.0/max(1U, radius));
-	bool const is_delta(!is_flatten_brush());
+	brush_weights_t const &bw(tmmm->get_brush_weights(*this, step_sz, num_steps));
+	unsigned const row_len(bw.get_row_len());
+	int const x0(x - (int)radius), y0(y - (int)radius), num_x(bw.num_x);
+	float const step_delta(1.0/num_steps), fdelta(delta);
+	bool const is_delta(!is_flatten_brush()), parallel(tmmm->brush_rows_are_disjoint(*this, step_sz, num_steps));
+
+	// rows only touch their own texture rows unless they're mirrored at the texture edge, so there's no write contention across threads
+#pragma omp parallel for schedule(dynamic,1) if (parallel)
+	for (int iy = 0; iy < num_x; ++iy) {
+		int const yp(y0 + iy*step_sz);
+		int ix1(num_x), ix2(-1); // union of x spans across sub-rows
+
+		for (unsigned sy = 0; sy < num_steps; ++sy) {
+			pair<int, int> const &span(bw.x_spans[iy*num_steps + sy]);
+			min_eq(ix1, span.first);
+			max_eq(ix2, span.second);
+		}
+		for (int ix = ix1; ix <= ix2; ++ix) {
+			int const xp(x0 + ix*step_sz);
 
-#pragma omp parallel for schedule(dynamic,1) // only ~1.8x faster
-	for (int yp = y - (int)radius; yp <= y + (int)radius; yp += step_sz) {
-		for (int xp = x - (int)radius; xp <= x + (int)radius; xp += step_sz) {
 			for (unsigned sy = 0; sy < num_steps; ++sy) {
+				float const *const w(bw.weights.data() + (iy*num_steps + sy)*row_len + ix*num_steps);
+
 				for (unsigned sx = 0; sx < num_steps; ++sx) {
-					float const dx(sx*step_delta), dy(sy*step_delta);
-					float const dist(sqrt(float(yp + dy - y)*float(yp + dy - y) + float(xp + dx - x)*float(xp + dx - x))), dval(dist*r_inv);
-					if (shape != BSHAPE_CONST_SQ && shape != BSHAPE_FLAT_SQ && dval > 1.0) continue; // round (instead of square)
-					float mod_delta(delta); // constant
-					adjust_brush_weight(mod_delta, dval, shape);
-					assert(tmmm);
-					tmmm->modify_height_value(xp, yp, round_fp(mod_delta), is_delta, dx, dy);
-				} // for sx
+					if (w[sx] < 0.0) continue; // outside the brush
+					tmmm->modify_height_value(xp, yp, round_fp(fdelta*w[sx]), is_delta, sx*step_delta, sy*step_delta);
+				}
 			} // for sy
-		} // for xp
-	} // for yp
+		} // for ix
+	} // for iy
+	for (int iy = 0; iy < num_x; ++iy) { // mark modified rows serially, after all values have been written
+		int ix1(num_x), ix2(-1);
+
+		for (unsigned sy = 0; sy < num_steps; ++sy) {
+			pair<int, int> const &span(bw.x_spans[iy*num_steps + sy]);
+			min_eq(ix1, span.first);
+			max_eq(ix2, span.second);
+		}
+		if (ix1 <= ix2) {tmmm->mark_modified_span(y0 + iy*step_sz, x0 + ix1*step_sz, x0 + ix2*step_sz);}
+	}
 }
 
 
@@ -110,19 +167,129 @@ void heightmap_t::modify_heightmap_value(unsigned x, unsigned y, int val, bool v
 	}
 }
 
-void heightmap_t::postprocess_height() {
+void heightmap_t::postprocess_height(vector<float> &vals, string const &cache_fn) { // vals is non-empty if eroded heights were read from the cache
+
+	bool const eroded(!vals.empty());
 
-	if (erosion_iters_tt == 0 && !have_cities()) return; // no erosion or cities => no need to update height values
+	if (!eroded && erosion_iters_tt == 0 && !have_cities()) { // no erosion or cities => no need to update height values
+		if (!cache_fn.empty()) {write_cache(cache_fn, nullptr);}
+		return;
+	}
 	timer_t timer("Postprocess Height");
 	assert(is_allocated());
 	assert(ncolors == 1 || ncolors == 2); // one or two byte grayscale
-	vector<float> vals;
-	to_floats   (vals);
-	run_erosion (vals);
-	run_city_gen(vals);
+
+	if (!eroded) {
+		to_floats  (vals);
+		run_erosion(vals);
+		if (!cache_fn.empty()) {write_cache(cache_fn, ((erosion_iters_tt > 0) ? &vals : nullptr));} // cache pixels if there's no erosion
+	}
+	run_city_gen(vals); // Note: not cached because city generation has side effects
 	from_floats (vals);
 }
 
+// binary heightmap cache: stores either the decoded image pixels or the eroded float heights, to skip image decoding and erosion on the next load
+unsigned const hmap_cache_sig     = 0xbeef4a4d;
+unsigned const hmap_cache_version = 2;
+
+struct hmap_cache_header_t {
+	unsigned sig=hmap_cache_sig, version=hmap_cache_version, width=0, height=0, ncolors=0, is_16_bit=0, invert_y=0, erosion_iters=0, has_floats=0, pad=0; // pad is explicit so that no uninitialized bytes are written
+	uint64_t src_size=0, src_mtime=0;
+	float val_mult=0.0, val_add=0.0, erode_amount=0.0, water_plane_z=0.0;
+
+	bool operator==(hmap_cache_header_t const &h) const { // all fields must match
+		return (sig == h.sig && version == h.version && width == h.width && height == h.height && ncolors == h.ncolors && is_16_bit == h.is_16_bit &&
+			invert_y == h.invert_y && erosion_iters == h.erosion_iters && has_floats == h.has_floats && src_size == h.src_size && src_mtime == h.src_mtime && val_mult == h.val_mult &&
+			val_add == h.val_add && erode_amount == h.erode_amount && water_plane_z == h.water_plane_z);
+	}
+};
+static_assert(sizeof(hmap_cache_header_t) == 10*sizeof(unsigned) + 2*sizeof(uint64_t) + 4*sizeof(float), "hmap_cache_header_t must not have implicit padding");
+
+bool heightmap_t::fill_cache_header(hmap_cache_header_t &header, bool has_floats) const {
+	FILE *fp(open_texture_file_no_check(name)); // source image size and modification time are used for invalidation
+	if (fp == nullptr) return 0;
+	struct stat st;
+	bool const stat_ok(fstat(fileno(fp), &st) == 0);
+	checked_fclose(fp);
+	if (!stat_ok) return 0; // can't validate the cache
+	header.src_size      = st.st_size;
+	header.src_mtime     = st.st_mtime;
+	header.invert_y      = invert_y;
+	header.erosion_iters = (has_floats ? erosion_iters_tt : 0);
+	header.has_floats    = has_floats;
+	header.val_mult      = get_mh_texture_mult();
+	header.val_add       = get_mh_texture_add();
+	header.erode_amount  = (has_floats ? erode_amount  : 0.0f);
+	header.water_plane_z = (has_floats ? water_plane_z : 0.0f);
+	return 1;
+}
+
+bool heightmap_t::read_cache(string const &fn, vector<float> &vals) {
+
+	assert(!is_allocated());
+	FILE *fp(fopen(fn.c_str(), "rb"));
+	if (fp == nullptr) return 0; // not yet written
+	hmap_cache_header_t header, expected;
+	bool valid(fread(&header, sizeof(hmap_cache_header_t), 1, fp) == 1 && fill_cache_header(expected, (erosion_iters_tt > 0)));
+
+	if (valid) {
+		expected.width   = header.width;
+		expected.height  = header.height;
+		expected.ncolors = header.ncolors;
+		expected.is_16_bit = header.is_16_bit;
+		valid = (header == expected && header.width > 0 && header.height > 0 && (header.ncolors == 1 || header.ncolors == 2));
+	}
+	if (!valid) {
+		cout << "Heightmap cache " << fn << " is invalid or out of date; ignoring it" << endl;
+		checked_fclose(fp);
+		return 0;
+	}
+	width  = header.width;
+	height = header.height;
+	if (header.is_16_bit) {set_16_bit_grayscale();} else {ncolors = header.ncolors;}
+	alloc();
+
+	if (header.has_floats) { // data will be written by from_floats()
+		vals.resize(num_pixels());
+		valid = (fread(vals.data(), sizeof(float), vals.size(), fp) == vals.size());
+	}
+	else {valid = (fread(data, 1, num_bytes(), fp) == num_bytes());}
+	checked_fclose(fp);
+
+	if (!valid) {
+		cerr << "Error reading heightmap cache " << fn << endl;
+		vals.clear();
+		free_client_mem();
+		*this = heightmap_t(type, format, 0, 0, name, invert_y); // reset to the unloaded state
+		return 0;
+	}
+	cout << "Read heightmap cache " << fn << endl;
+	return 1;
+}
+
+void heightmap_t::write_cache(string const &fn, vector<float> const *vals) const {
+
+	assert(is_allocated());
+	hmap_cache_header_t header;
+	if (!fill_cache_header(header, (vals != nullptr))) return;
+	header.width     = width;
+	header.height    = height;
+	header.ncolors   = ncolors;
+	header.is_16_bit = is_16_bit_gray;
+	FILE *fp(fopen(fn.c_str(), "wb"));
+
+	if (fp == nullptr) {
+		cerr << "Error opening heightmap cache " << fn << " for write" << endl;
+		return;
+	}
+	timer_t timer("Write Heightmap Cache");
+	bool valid(fwrite(&header, sizeof(hmap_cache_header_t), 1, fp) == 1);
+	if (vals) {assert(vals->size() == num_pixels()); valid &= (fwrite(vals->data(), sizeof(float), vals->size(), fp) == vals->size());}
+	else {valid &= (fwrite(data, 1, num_bytes(), fp) == num_bytes());}
+	checked_fclose(fp);
+	if (!valid) {cerr << "Error writing heightmap cache " << fn << endl;}
+}
+
 void heightmap_t::proc_gen() {
 	set_16_bit_grayscale();
 	alloc();
@@ -343,9 +510,11 @@ void terrain_hmap_manager_t::load(char const *const fn, bool invert_y) {
 	timer_t timer("Heightmap Load");
 	assert(!hmap.is_allocated()); // can only call once
 	hmap = heightmap_t(0, 7, 0, 0, fn, invert_y);
-	hmap.load(-1, 0, 1, 1);
+	vector<float> vals; // filled with eroded heights if read from the cache
+	bool const from_cache(!hmap_cache_fn.empty() && hmap.read_cache(hmap_cache_fn, vals));
+	if (!from_cache) {hmap.load(-1, 0, 1, 1);}
 	timer.end();
-	hmap.postprocess_height(); // apply erosion, etc. directly after loading/generating, before applying mod brushes
+	hmap.postprocess_height(vals, (from_cache ? "" : hmap_cache_fn)); // apply erosion, etc. directly after loading/generating, before applying mod brushes
 	post_load();
 }
 
@@ -408,6 +577,15 @@ vector3d terrain_hmap_manager_t::get_norm(int x, int y) const {
 	return vector3d(DY_VAL*(h0 - get_clamped_height(x+1, y)), DX_VAL*(h0 - get_clamped_height(x, y+1)), dxdy).get_norm();
 }
 
+bool terrain_hmap_manager_t::brush_rows_are_disjoint(hmap_brush_t const &b, int step_sz, unsigned num_steps) const {
+	if (!enabled()) return 0;
+	// sub-rows must be at least one texel apart, which is the case when mesh_scale is a power of 2
+	if (mesh_scale*step_sz < 1.0f || (num_steps > 1 && mesh_scale < num_steps)) return 0;
+	// the rows of a brush that's entirely inside the texture in y are never mirrored; max sub-step fraction is < 1.0
+	int const y1(round_fp(mesh_scale*(b.y - (int)b.radius)) + hmap.height/2), y2(round_fp(mesh_scale*(b.y + (int)b.radius + 1.0f)) + hmap.height/2);
+	return (y1 >= 0 && y2 < hmap.height);
+}
+
 void terrain_hmap_manager_t::modify_height(mod_elem_t const &elem, bool is_delta) {
 	assert((unsigned)max(hmap.width, hmap.height) <= max_tex_ix());
 	hmap.modify_heightmap_value(elem.x, elem.y, elem.delta, is_delta);
@@ -433,6 +611,8 @@ void terrain_hmap_manager_t::apply_cur_mod_map() {
 }
 
 void terrain_hmap_manager_t::apply_cur_brushes() { // apply the brushes to the current texture
+	if (brush_vect.empty()) return;
+	timer_t timer("Apply Heightmap Brushes (" + std::to_string(brush_vect.size()) + ")");
 	for (brush_vect_t::const_iterator i = brush_vect.begin(); i != brush_vect.end(); ++i) {apply_brush(*i);}
 }
 
@@ -14,6 +14,8 @@ float scale_mh_texture_val(float val);
 float unscale_mh_texture_val(float val);
 void adjust_brush_weight(float &delta, float dval, int shape);
 
+struct hmap_cache_header_t;
+
 
 class heightmap_t : public texture_t {
 
@@ -23,6 +25,7 @@ class heightmap_t : public texture_t {
 	void run_city_gen(vector<float> &vals);
 	void to_floats   (vector<float> &vals) const;
 	void from_floats (vector<float> const &vals);
+	bool fill_cache_header(hmap_cache_header_t &header, bool has_floats) const;
 public:
 	heightmap_t() {}
 	heightmap_t(char t, char f, int w, int h, std::string const &n, bool inv) :
@@ -30,7 +33,9 @@ public:
 	unsigned get_pixel_value (unsigned x, unsigned y) const;
 	float get_heightmap_value(unsigned x, unsigned y) const;
 	void modify_heightmap_value(unsigned x, unsigned y, int val, bool val_is_delta);
-	void postprocess_height();
+	void postprocess_height(vector<float> &vals, std::string const &cache_fn);
+	bool read_cache (std::string const &fn, vector<float> &vals);
+	void write_cache(std::string const &fn, vector<float> const *vals) const;
 	void proc_gen();
 };
 
@@ -83,9 +88,32 @@ public:
 	typedef vector<mod_elem_t> tex_mod_vect_t;
 	typedef vector<hmap_brush_t> brush_vect_t;
 
+	struct brush_weights_t { // precomputed per-sample weights for a brush radius/shape/step; reused across brushes, e.g. when replaying a modmap
+		unsigned radius=0, num_steps=0, num_x=0;
+		int step_sz=0;
+		short shape=-1;
+		vector<float> weights; // one per sub-sample; negative if outside the brush
+		vector<pair<int, int>> x_spans; // range of valid x indices for each row of samples; first > second if empty
+
+		bool matches(hmap_brush_t const &b, int step_sz_, unsigned num_steps_) const {
+			return (b.radius == radius && b.shape == shape && step_sz_ == step_sz && num_steps_ == num_steps);
+		}
+		void calc(hmap_brush_t const &b, int step_sz_, unsigned num_steps_);
+		unsigned get_row_len() const {return num_x*num_steps;}
+	};
+
 protected:
 	tex_mod_map_t mod_map;
 	brush_vect_t brush_vect;
+	brush_weights_t brush_weights;
+
+	brush_weights_t const &get_brush_weights(hmap_brush_t const &b, int step_sz, unsigned num_steps) {
+		if (!brush_weights.matches(b, step_sz, num_steps)) {brush_weights.calc(b, step_sz, num_steps);}
+		return brush_weights;
+	}
+	// returns true if each row of the brush maps to a different row of the texture, so that rows can be modified in parallel
+	virtual bool brush_rows_are_disjoint(hmap_brush_t const &b, int step_sz, unsigned num_steps) const {return 0;}
+	virtual void mark_modified_span(int y, int x1, int x2) {} // called for each modified brush row with the inclusive x range
 
 public:
 	void add_mod(mod_elem_t const &elem) {mod_map.add(elem);}
@@ -126,6 +154,7 @@ public:
 	float interpolate_height(float x, float y) const;
 	float get_nearest_height(float x, float y) const;
 	vector3d get_norm(int x, int y) const;
+	virtual bool brush_rows_are_disjoint(hmap_brush_t const &b, int step_sz, unsigned num_steps) const;
 
 	virtual bool modify_height_value(int x, int y, hmap_val_t val, bool is_delta, float fract_x=0.0, float fract_y=0.0, bool allow_wrap=1) { // unused
 		assert(fract_x == 0.0 && fract_y == 0.0);
@@ -141,17 +141,18 @@ public:
 
 class physics_particle_manager {
 protected:
-	struct part_t { // size = 28
-		point p; // position
-		vector3d v; // velocity
-		color_wrapper c;
-
-		part_t() {}
-		part_t(point const &p_, vector3d const &v_, colorRGBA const &c_) : p(p_), v(v_) {c.set_c4(c_);}
-	};
-	vector<part_t> parts;
+	// particle attributes are stored in separate parallel arrays so that integration and drawing only touch what they use
+	vector<point> ppos;
+	vector<vector3d> vel;
+	vector<color_wrapper> colors;
+	vector<unsigned char> keep; // temporary per-particle flags for apply_physics()
+
+	void add_particle(point const &p, vector3d const &v, colorRGBA const &c);
+	void remove_dead_particles();
 public:
-	void clear() {parts.clear();}
+	unsigned size() const {return (unsigned)ppos.size();}
+	bool empty() const {return ppos.empty();}
+	void clear() {ppos.clear(); vel.clear(); colors.clear();}
 	void gen_particles(point const &pos, vector3d const &vadd, float vmag, float gen_radius, colorRGBA const &color, unsigned num);
 	void apply_physics(float gravity, float terminal_velocity, bool emissive=0);
 	void draw(float radius, int tid, bool emissive=0) const;
@@ -191,6 +192,17 @@ struct decal_obj : public basic_physics_obj { // size = 76
 };
 
 
+struct phys_step_t { // timestep used to advance an object; objects may be advanced in several substeps per frame
+	float timestep=0.0, tstep=0.0; // TIMESTEP and TIMESTEP*fticks for this step
+
+	phys_step_t() {}
+	phys_step_t(float timestep_, float tstep_) : timestep(timestep_), tstep(tstep_) {}
+	phys_step_t get_substep(unsigned num_steps) const {assert(num_steps > 0); return phys_step_t(timestep/num_steps, tstep/num_steps);}
+};
+
+phys_step_t get_frame_phys_step(); // from the global TIMESTEP and tstep
+
+
 struct dwobject : public basic_physics_obj { // size = 67(68) (dynamic world object)
 
 	int coll_id=-1;
@@ -205,17 +217,17 @@ struct dwobject : public basic_physics_obj { // size = 67(68) (dynamic world obj
 	float get_true_radius() const;
 	float get_true_density() const;
 	float get_true_mass() const;
-	void advance_object(bool disable_motionless_objects, int iter, int obj_index);
-	int surface_advance();
+	void advance_object(bool disable_motionless_objects, int iter, int obj_index, phys_step_t const &step);
+	int surface_advance(phys_step_t const &step);
 	void set_orient_for_coll(vector3d const *const forced_norm);
-	int check_water_collision(float vz_old);
+	int check_water_collision(float vz_old, phys_step_t const &step);
 	void surf_collide_obj() const;
 	void elastic_collision(point const &obj_pos, float energy, int obj_type);
 	int object_bounce(int coll_type, vector3d &norm, float elasticity2, float z_offset, vector3d const &obj_vel=zero_vector);
 	int object_still_stopped(int obj_index);
 	void do_coll_damage();
 	int check_vert_collision(int obj_index, int do_coll_funcs, int iter, vector3d *cnorm=NULL,
-		vector3d const &mdir=all_zeros, bool skip_dynamic=0, bool only_drawn=0, int only_cobj=-1, bool skip_movable=0);
+		vector3d const &mdir=all_zeros, bool skip_dynamic=0, bool only_drawn=0, int only_cobj=-1, bool skip_movable=0, phys_step_t const *step=nullptr);
 	int multistep_coll(point const &last_pos, int obj_index, unsigned nsteps);
 	void update_vel_from_damage(vector3d const &dv);
 	void damage_object(float damage, point const &dpos, point const &shoot_pos, int weapon);
@@ -243,6 +255,7 @@ class vert_coll_detector {
 	point pos, pold;
 	vector3d motion_dir, obj_vel;
 	vector3d *cnorm;
+	phys_step_t step;
 	dwobject temp;
 
 	bool safe_norm_div(float rad, float radius, vector3d &norm);
@@ -250,10 +263,10 @@ class vert_coll_detector {
 	void init_reset_pos();
 public:
 	vert_coll_detector(dwobject &obj_, int obj_index_, int do_coll_funcs_, int iter_, vector3d *cnorm_,
-		vector3d const &mdir=zero_vector, bool skip_dynamic_=0, bool only_drawn_=0, int only_cobj_=-1, bool skip_movable_=0) :
+		vector3d const &mdir=zero_vector, bool skip_dynamic_=0, bool only_drawn_=0, int only_cobj_=-1, bool skip_movable_=0, phys_step_t const *step_=nullptr) :
 	obj(obj_), type(obj.type), iter(iter_), player(type == CAMERA || type == SMILEY || type == WAYPOINT), skip_dynamic(skip_dynamic_), only_drawn(only_drawn_),
 		skip_movable(skip_movable_), obj_index(obj_index_), do_coll_funcs(do_coll_funcs_), only_cobj(only_cobj_), z_old(obj.pos.z), 
-		pos(obj.pos), pold(obj.pos), motion_dir(mdir), obj_vel(obj.velocity), cnorm(cnorm_) {}
+		pos(obj.pos), pold(obj.pos), motion_dir(mdir), obj_vel(obj.velocity), cnorm(cnorm_), step(step_ ? *step_ : get_frame_phys_step()) {}
 
 	void check_cobj(int index);
 	int check_coll();
@@ -75,6 +75,8 @@ public:
 	wpt_ix_t add(waypoint_t const &w);
 	void remove(wpt_ix_t ix);
 	void clear() {vector<waypoint_t>::clear(); free_list.clear();}
+	bool read_cache (std::string const &fn, unsigned key);
+	void write_cache(std::string const &fn, unsigned key) const;
 };
 
 
@@ -104,12 +104,22 @@ struct smoke_manager {
 
 		if (is_smoke_visible(pos) && check_smoke_bounds(pos)) {
 			bbox.union_with_pt(pos);
-			cur_smoke_bb.union_with_pt(pos);
 			smoke_vis = 1;
 		}
 		tot_smoke += smoke_amt;
 		enabled    = 1;
 	}
+	void merge(smoke_manager const &m) { // merge in a partial result; updates cur_smoke_bb
+		if (!m.enabled) return;
+
+		if (m.smoke_vis) {
+			bbox.union_with_cube(m.bbox);
+			cur_smoke_bb.union_with_cube(m.bbox);
+			smoke_vis = 1;
+		}
+		tot_smoke += m.tot_smoke;
+		enabled    = 1;
+	}
 	void adj_bbox() {
 		for (unsigned i = 0; i < 3; ++i) {
 			float const dval(SCENE_SIZE[i]/MESH_SIZE[i]);
@@ -186,7 +196,7 @@ void distribute_smoke() { // called at most once per frame
 
 	//RESET_TIME;
 	if (!DYNAMIC_SMOKE || !smoke_exists || !animate2) return;
-	assert(SMOKE_SKIPVAL > 0);
+	assert(SMOKE_SKIPVAL >= 3); // required for rows to be processed in parallel
 	static int cur_skip(0);
 	static rand_gen_t rgen;
 	
@@ -200,9 +210,16 @@ void distribute_smoke() { // called at most once per frame
 	}
 	float const xy_rate(SMOKE_DIS_XY*SMOKE_SKIPVAL);
 	int const dx(rgen.rand() & 1), dy(rgen.rand() & 1); // randomize the processing order
+	int const num_rows((MESH_Y_SIZE - cur_skip + SMOKE_SKIPVAL - 1)/SMOKE_SKIPVAL);
+	smoke_grid.ensure_zrng(); // allocate before the parallel loop
 	
-	// openmp doesn't really help here
-	for (int y = cur_skip; y < MESH_Y_SIZE; y += SMOKE_SKIPVAL) { // split the computation across several frames
+	// rows processed in the same frame are SMOKE_SKIPVAL apart, and each row only modifies itself and its adjacent rows,
+	// so rows can be processed in parallel with the same result as serial processing
+#pragma omp parallel for schedule(dynamic,1)
+	for (int row = 0; row < num_rows; ++row) { // split the computation across several frames
+		int const y(cur_skip + row*SMOKE_SKIPVAL);
+		smoke_manager row_smoke_man;
+
 		for (int x = 0; x < MESH_X_SIZE; ++x) {
 			lmcell *vldata(lmap_manager.get_column(x, y));
 			if (vldata == NULL) continue;
@@ -216,7 +233,7 @@ void distribute_smoke() { // called at most once per frame
 				if (lmc.smoke < SMOKE_THRESH) {lmc.smoke = 0.0;}
 				if (lmc.smoke == 0.0) continue;
 				//if (get_zval(z) > v_collision_matrix[y][x].zmax) {lmc.smoke = 0.0; continue;} // open space above - smoke goes up
-				next_smoke_man.add_smoke(x, y, z, lmc.smoke);
+				row_smoke_man.add_smoke(x, y, z, lmc.smoke);
 
 				if (dx) {
 					diffuse_smoke_xy(x+1, y, z, lmc, xy_rate, 0, 1);
@@ -238,7 +255,9 @@ void distribute_smoke() { // called at most once per frame
 			} // for z
 			if (!any_z_has_smoke) {zrange.clear();} // mark this xy as not having smoke
 		} // for x
-	} // for y
+#pragma omp critical(smoke_man_merge)
+		next_smoke_man.merge(row_smoke_man);
+	} // for row
 	cur_skip = (cur_skip+1) % SMOKE_SKIPVAL;
 	//PRINT_TIME("Distribute Smoke");
 }
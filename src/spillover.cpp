@@ -16,24 +16,35 @@ void spillover::init(unsigned max_index) {
 void spillover::insert(unsigned index1, unsigned index2) { // insert index2 into index1 (source, dest)
 	assert(index1 < data.size() && index2 < data.size());
 	assert(index1 != index2);
-	data[index1].insert(index2);
+	graph_node &n(data[index1]);
+	auto it(std::lower_bound(n.begin(), n.end(), index2));
+	if (it != n.end() && *it == index2) return; // already present (common case), components are unchanged
+	n.insert(it, index2);
+	comps_valid = 0;
 }
 
 void spillover::remove(unsigned index1, unsigned index2) { // remove index2 from index1
 	assert(index1 < data.size() && index2 < data.size());
 	assert(index1 != index2);
-	data[index1].erase(index2);
+	graph_node &n(data[index1]);
+	auto it(std::lower_bound(n.begin(), n.end(), index2));
+	if (it == n.end() || *it != index2) return; // not present
+	n.erase(it);
+	comps_valid = 0;
 }
 
 void spillover::remove_all_i(unsigned index1) { // remove outgoing edges
 	assert(index1 < data.size());
+	if (data[index1].empty()) return;
 	data[index1].clear();
+	comps_valid = 0;
 }
 
 void spillover::remove_connected(unsigned index1) { // remove incoming edges
 
 	assert(index1 < data.size());
-	set<unsigned> const sdata(data[index1]); // have to copy the set so that we can modify the original
+	if (data[index1].empty()) return;
+	vector<unsigned> const sdata(data[index1]); // have to copy the edges so that we can modify the original
 
 	for (auto j = sdata.begin(); j != sdata.end(); ++j) {
 		if (member(*j, index1)) {remove(index1, *j);}
@@ -43,72 +54,89 @@ void spillover::remove_connected(unsigned index1) { // remove incoming edges
 bool spillover::member(unsigned index1, unsigned index2) const { // index2 is a member of index1
 	assert(index1 < data.size() && index2 < data.size());
 	assert(index1 != index2);
-	return (data[index1].find(index2) != data[index1].end());
-}
-
-bool spillover::member_deep(unsigned index1, unsigned index2) {
-	assert(index2 < data.size());
-	++cur_seen_ix; // invalidate seen values
-	return member_recur(index1, index2);
+	return std::binary_search(data[index1].begin(), data[index1].end(), index2);
 }
 
-bool spillover::member_recur(unsigned index1, unsigned index2, bool use_cache, vector<unsigned char> *used) { // index2 is a member of index1
-
+bool spillover::member2way(unsigned index1, unsigned index2) { // each is reachable from the other
+	assert(index1 < data.size() && index2 < data.size());
 	assert(index1 != index2);
-	data[index1].seen = cur_seen_ix;
-	if (used != nullptr && (*used)[index1]) return 0; // already used
-	if (use_cache && data[index1].unconnected == cur_connected) return 0;
-	if (use_cache && data[index1].connected   == cur_connected) return 1;
-
-	for (auto i = data[index1].begin(); i != data[index1].end(); ++i) {
-		assert(*i < data.size());
-		if (*i == index2) return 1; // found it
-		if (data[*i].seen == cur_seen_ix) continue; // already seen
-		
-		if (member_recur(*i, index2, use_cache, used)) {
-			if (use_cache) {data[*i].connected = cur_connected;}
-			return 1;
-		}
-	}
-	return 0;
+	calc_components();
+	return (comp_id[index1] == comp_id[index2]);
 }
 
-bool spillover::member2way(unsigned index1, unsigned index2) {
-	return (member_deep(index1, index2) && member_deep(index2, index1));
+void spillover::calc_components() { // Tarjan's strongly connected components algorithm, non-recursive
+
+	if (comps_valid) return;
+	unsigned const num(data.size());
+	vector<unsigned> index(num, 0), lowlink(num, 0), stack; // index 0 = not yet visited
+	vector<unsigned char> on_stack(num, 0);
+	vector<pair<unsigned, unsigned>> calls; // {node, next edge}
+	unsigned next_index(1), num_comps(0);
+	comp_id.resize(num);
+
+	for (unsigned root = 0; root < num; ++root) {
+		if (index[root]) continue; // already visited
+		index[root] = lowlink[root] = next_index++;
+		stack.push_back(root);
+		on_stack[root] = 1;
+		calls.emplace_back(root, 0);
+
+		while (!calls.empty()) {
+			unsigned const v(calls.back().first);
+
+			if (calls.back().second < data[v].size()) { // visit next edge
+				unsigned const w(data[v][calls.back().second++]);
+
+				if (!index[w]) { // recurse
+					index[w] = lowlink[w] = next_index++;
+					stack.push_back(w);
+					on_stack[w] = 1;
+					calls.emplace_back(w, 0);
+				}
+				else if (on_stack[w]) {lowlink[v] = min(lowlink[v], index[w]);}
+				continue;
+			}
+			if (lowlink[v] == index[v]) { // v is the root of a component
+				unsigned w(0);
+				do {
+					w = stack.back();
+					stack.pop_back();
+					on_stack[w] = 0;
+					comp_id [w] = num_comps;
+				} while (w != v);
+				++num_comps;
+			}
+			calls.pop_back();
+			if (!calls.empty()) {unsigned &ll(lowlink[calls.back().first]); ll = min(ll, lowlink[v]);}
+		} // while
+	} // for root
+	assert(stack.empty());
+	comps_valid = 1;
 }
 
-void spillover::get_fanout(unsigned index1, vector<unsigned> &fanout, vector<unsigned char> *used) {
+void spillover::get_component_fanout(unsigned index1, vector<unsigned> &fanout, vector<unsigned char> const *used) {
 	
 	for (auto i = data[index1].begin(); i != data[index1].end(); ++i) {
 		assert(*i < data.size());
+		if (comp_id[*i] != comp_id[index1])  continue; // different component
 		if (used != nullptr && (*used)[*i]) continue; // already used
 		if (data[*i].seen == cur_seen_ix)   continue; // already seen
 		data[*i].seen = cur_seen_ix;
 		fanout.push_back(*i);
-		get_fanout(*i, fanout, used);
+		get_component_fanout(*i, fanout, used);
 	}
 }
 
+// returns the other nodes in the same component as index1, in depth first order;
+// any path between two nodes of a component stays within that component, so this is the same as filtering a full depth first traversal
 void spillover::get_connected_components(unsigned index1, vector<unsigned> &cc, vector<unsigned char> *used) {
 
 	cc.resize(0);
 	assert(index1 < data.size());
 	if (data[index1].empty()) return;
-	++cur_seen_ix;   // invalidate seen values
-	++cur_connected; // invalidate connected/unconnected
+	calc_components();
+	++cur_seen_ix; // invalidate seen values
 	data[index1].seen = cur_seen_ix;
-	fanout.resize(0);
-	get_fanout(index1, fanout, used); // excludes index1
-
-	for (auto i = fanout.begin(); i != fanout.end(); ++i) {
-		assert(*i != index1);
-		++cur_seen_ix; // invalidate seen values
-		bool const ret(member_recur(*i, index1, 1, used));
-		(ret ? data[*i].connected : data[*i].unconnected) = cur_connected;
-		if (ret) {cc.push_back(*i);}
-	}
+	get_component_fanout(index1, cc, used); // excludes index1
 }
 
-
-
-
@@ -6,30 +6,33 @@
 #include "3DWorld.h" // need iterator #defs
 
 
+// directed graph of valleys spilling into other valleys; connected components are the strongly connected components of this graph,
+// which are cached and only recomputed after an edge has been added or removed
 class spillover {
 
 public:
-	spillover() : cur_seen_ix(1), cur_connected(1) {}
-	void clear() {data.clear(); cur_seen_ix = cur_connected = 1;}
+	spillover() : cur_seen_ix(1), comps_valid(0) {}
+	void clear() {data.clear(); comp_id.clear(); cur_seen_ix = 1; comps_valid = 0;}
 	void init(unsigned max_index);
 	void insert(unsigned index1, unsigned index2);
 	void remove(unsigned index1, unsigned index2);
 	void remove_all_i(unsigned index1);
 	void remove_connected(unsigned index1);
 	bool member(unsigned index1, unsigned index2) const;
-	bool member_deep(unsigned index1, unsigned index2);
-	bool member_recur(unsigned index1, unsigned index2, bool use_cache=0, vector<unsigned char> *used=nullptr);
 	bool member2way(unsigned index1, unsigned index2);
-	void get_fanout(unsigned index1, vector<unsigned> &fanout, vector<unsigned char> *used);
 	void get_connected_components(unsigned index1, vector<unsigned> &cc, vector<unsigned char> *used=nullptr);
 
 private:
-	struct graph_node : public set<unsigned> {
-		unsigned seen, connected, unconnected;
-		graph_node() : seen(0), connected(0), unconnected(0) {}
+	struct graph_node : public vector<unsigned> { // sorted outgoing edges
+		unsigned seen;
+		graph_node() : seen(0) {}
 	};
 	vector<graph_node> data;
-	vector<unsigned> fanout;
-	unsigned cur_seen_ix, cur_connected;
+	vector<unsigned> comp_id; // strongly connected component index of each node
+	unsigned cur_seen_ix;
+	bool comps_valid;
+
+	void calc_components();
+	void get_component_fanout(unsigned index1, vector<unsigned> &fanout, vector<unsigned char> const *used);
 };
 
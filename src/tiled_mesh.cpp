@@ -8,6 +8,7 @@
 #include "openal_wrap.h"
 #include "heightmap.h"
 #include "profiler.h"
+#include <list>
 
 
 bool const DEBUG_TILES        = 0;
@@ -24,6 +25,7 @@ float const DRAW_DIST_TILES   = 1.5;
 float const CREATE_DIST_TILES = 1.6;
 float const CLEAR_DIST_TILES  = 1.6;
 float const DELETE_DIST_TILES = 1.8;
+size_t const TILE_CACHE_MAX_MEM = (64ULL<<20); // 64MB; 0 = disable
 float const GRASS_LOD_SCALE   = 15.0; // smaller = more grass detail
 float const GRASS_DIST_SLOPE  = 0.25;
 float const GRASS_THRESH      = 1.6;
@@ -62,7 +64,7 @@ extern bool use_instanced_pine_trees, enable_tt_model_reflect, water_is_lava, tt
 extern bool player_in_int_elevator, player_in_mall;
 extern unsigned grass_density, max_unique_trees, shadow_map_sz, erosion_iters_tt, num_rnd_grass_blocks, tiled_terrain_gen_heightmap_sz;
 extern unsigned num_birds_per_tile, num_fish_per_tile, num_bflies_per_tile, room_geom_mem;
-extern int DISABLE_WATER, display_mode, tree_mode, leaf_color_changed, ground_effects_level, animate2, iticks, num_trees, window_width, window_height, player_in_basement;
+extern int DISABLE_WATER, mesh_rgen_index, display_mode, tree_mode, leaf_color_changed, ground_effects_level, animate2, iticks, num_trees, window_width, window_height, player_in_basement;
 extern int invert_mh_image, is_cloudy, camera_surf_collide, show_fog, mesh_gen_mode, mesh_gen_shape, cloud_model, precip_mode, auto_time_adv, draw_model;
 extern int player_in_elevator, player_in_attic;
 extern float zmax, zmin, water_plane_z, mesh_scale, mesh_scale_z, vegetation, relh_adj_tex, grass_length, grass_width, fticks, cloud_height_offset, clouds_per_tile;
@@ -185,6 +187,65 @@ void update_tiled_grass_colors() {grass_tile_manager.clear();} // regenerate gra
 #define BILINEAR_INTERP(arr, var, x, y) (y*(x*arr[1][1].var + (1.0f-x)*arr[1][0].var) + (1.0f-y)*(x*arr[0][1].var + (1.0f-x)*arr[0][0].var))
 
 
+// *** evicted tile cache ***
+
+
+class tile_cache_t { // caches zvals and AO of tiles that were deleted for going out of range; cleared when the mesh changes
+
+	struct entry_t {
+		tile_t::cached_data_t data;
+		std::list<tile_xy_pair>::iterator lru_it;
+	};
+	typedef unordered_map<tile_xy_pair, entry_t, hash_tile_xy_pair> entry_map;
+	entry_map entries;
+	std::list<tile_xy_pair> lru_order; // most recently used first
+	size_t mem_usage=0;
+	unsigned num_hits=0, num_misses=0;
+
+	void erase(entry_map::iterator it) {
+		mem_usage -= it->second.data.get_mem();
+		lru_order.erase(it->second.lru_it);
+		entries.erase(it);
+	}
+	void evict_lru() {
+		assert(!lru_order.empty());
+		auto it(entries.find(lru_order.back()));
+		assert(it != entries.end());
+		erase(it);
+	}
+public:
+	bool lookup(tile_xy_pair const &tp, tile_t &tile) {
+		auto it(entries.find(tp));
+		if (it == entries.end()) {++num_misses; return 0;}
+		if (!tile.restore_cached_data(it->second.data)) {erase(it); ++num_misses; return 0;} // stale entry
+		lru_order.splice(lru_order.begin(), lru_order, it->second.lru_it); // move to front
+		++num_hits;
+		return 1;
+	}
+	void add(tile_xy_pair const &tp, tile_t const &tile) {
+		if (TILE_CACHE_MAX_MEM == 0 || !tile.can_cache()) return;
+		auto it(entries.find(tp));
+		if (it != entries.end()) {erase(it);}
+		entry_t &entry(entries[tp]);
+		tile.save_cached_data(entry.data);
+		lru_order.push_front(tp);
+		entry.lru_it = lru_order.begin();
+		mem_usage += entry.data.get_mem();
+		while (mem_usage > TILE_CACHE_MAX_MEM && entries.size() > 1) {evict_lru();}
+	}
+	void clear() {
+		entries.clear();
+		lru_order.clear();
+		mem_usage = 0;
+	}
+	void print_stats() const {
+		cout << "tile cache: " << entries.size() << " tiles, MB: " << in_mb(mem_usage) << ", hits: " << num_hits << ", misses: " << num_misses << endl;
+	}
+};
+
+tile_cache_t tile_cache;
+
+
 // *** heightmap management ***
 
 
@@ -208,6 +269,7 @@ public:
 		int const step_sz(max(1, int(1.0/mesh_scale + SMALL_NUMBER))); // Note: only intended to work when mesh_scale is a power of 0.5 (or generally an integer reciprocol)
 		unsigned const num_steps(max(1U, unsigned(mesh_scale + SMALL_NUMBER))); // Note: only intended to work when mesh_scale is a power of 2 (or generally an integer)
 		if (cache) {apply_and_cache_brush(brush, step_sz, num_steps);} else {terrain_hmap_manager_t::apply_brush(brush, step_sz, num_steps);}
+		tile_cache.clear(); // cached tiles may overlap the modified area
 		if (cur_tile == NULL) return; // no tile specified, so can't do any updates
 		tile_xy_pair const tp(cur_tile->get_tile_xy_pair());
 
@@ -252,9 +314,11 @@ public:
 		if (!clamp_xy(clamped_x, clamped_y, fract_x, fract_y, allow_wrap)) return 0;
 		assert(clamped_x >= 0 && clamped_y >= 0);
 		modify_height(tex_mod_map_manager_t::mod_elem_t(clamped_x, clamped_y, val), is_delta); // Note: *not* cached at this level
-		if (cur_tile) {cur_tile->fill_adj_mask(modified, x, y);}
 		return 1;
 	}
+	virtual void mark_modified_span(int y, int x1, int x2) {
+		if (cur_tile) {cur_tile->fill_adj_mask_span(modified, x1, x2, y);}
+	}
 };
 
 
@@ -342,6 +406,15 @@ void tile_t::fill_adj_mask(bool mask[3][3], int x, int y) const { // mask is {y-
 	if (x >= x2) {mask[1][2] |= 1; mask[0][2] |= (y <= y1); mask[2][2] |= (y >= y2);} // right + top/bottom right corners
 	mask[0][1] |= (y <= y1); mask[2][1] |= (y >= y2); // top/bottom edges
 }
+// same as calling fill_adj_mask() for each x in [xa, xb]
+void tile_t::fill_adj_mask_span(bool mask[3][3], int xa, int xb, int y) const {
+
+	assert(xa <= xb);
+	if (xa <= x2 && xb >= x1 && y >= y1 && y <= y2) {mask[1][1] |= 1;} // ourself
+	if (xa <= x1) {mask[1][0] |= 1; mask[0][0] |= (y <= y1); mask[2][0] |= (y >= y2);} // left  + top/bottom left  corners
+	if (xb >= x2) {mask[1][2] |= 1; mask[0][2] |= (y <= y1); mask[2][2] |= (y >= y2);} // right + top/bottom right corners
+	mask[0][1] |= (y <= y1); mask[2][1] |= (y >= y2); // top/bottom edges
+}
 
 
 float tile_t::get_min_dist_to_pt(point const &pt, bool xy_only, bool mesh_only) const {
@@ -567,6 +640,53 @@ float tile_t::get_zval_at(float x, float y, bool in_global_space) const {
 }
 
 
+unsigned get_tile_gen_params_hash() { // hash of the global params that affect create_zvals() and calc_mesh_ao_lighting()
+	bool const using_hmap(using_tiled_terrain_hmap_tex()), add_detail(using_hmap_with_detail());
+	int const ivals[] = {mesh_gen_mode, mesh_gen_shape, mesh_rgen_index, int(erosion_iters_tt), enable_tiled_mesh_ao, enable_terrain_env, using_hmap, add_detail};
+	float const fvals[] = {mesh_scale, mesh_scale_z, zmin, zmax, water_plane_z, get_max_sea_level(), get_mh_texture_mult(), get_mh_texture_add(), DX_VAL, DY_VAL};
+	return (jenkins_one_at_a_time_hash((uint8_t const *)ivals, sizeof(ivals)) ^ (31*jenkins_one_at_a_time_hash((uint8_t const *)fvals, sizeof(fvals))));
+}
+
+void tile_t::save_cached_data(cached_data_t &data) const {
+
+	assert(can_cache());
+	data.zvals       = zvals;
+	data.ao_lighting = ao_lighting;
+	for (unsigned i = 0; i < 4; ++i) {data.params[i>>1][i&1] = params[i>>1][i&1];}
+	memcpy(data.sub_zmin, sub_zmin, sizeof(sub_zmin));
+	memcpy(data.sub_zmax, sub_zmax, sizeof(sub_zmax));
+	data.radius  = radius;
+	data.mzmin   = mzmin;
+	data.mzmax   = mzmax;
+	data.mesh_dz = mesh_dz;
+	data.wx1 = wx1; data.wy1 = wy1; data.wx2 = wx2; data.wy2 = wy2;
+	data.inside_city = inside_city;
+	data.no_trees    = no_trees;
+	data.size        = size;
+	data.gen_params_hash = get_tile_gen_params_hash();
+}
+
+bool tile_t::restore_cached_data(cached_data_t const &data) { // used in place of create_zvals()
+
+	if (data.size != size || data.zvals.size() != zvsize*zvsize) return 0; // tile size changed
+	if (data.gen_params_hash != get_tile_gen_params_hash())     return 0; // generation params changed
+	zvals       = data.zvals;
+	ao_lighting = data.ao_lighting;
+	for (unsigned i = 0; i < 4; ++i) {params[i>>1][i&1] = data.params[i>>1][i&1];}
+	memcpy(sub_zmin, data.sub_zmin, sizeof(sub_zmin));
+	memcpy(sub_zmax, data.sub_zmax, sizeof(sub_zmax));
+	radius  = data.radius;
+	mzmin   = data.mzmin;
+	mzmax   = data.mzmax;
+	mesh_dz = data.mesh_dz;
+	wx1 = data.wx1; wy1 = data.wy1; wx2 = data.wx2; wy2 = data.wy2;
+	inside_city = data.inside_city;
+	no_trees    = data.no_trees;
+	ptzmax = dtzmax = mzmin; // no trees yet
+	return 1;
+}
+
+
 // *** shadows + AO lighting ***
 
 void tile_t::calc_mesh_ao_lighting() {
@@ -590,6 +710,21 @@ void tile_t::calc_mesh_ao_lighting() {
 	vector<float> czv;
 	mesh_xy_grid_cache_t height_gen;
 	
+	// adjacent tile zvals are the same as the values we would generate for the context border if they come from the same CPU source with no erosion,
+	// detail noise, or per-tile height scale applied; GPU heights and heightmap detail noise may differ slightly from a CPU re-evaluation, so skip those
+	float const *adj_zvals[3][3] = {}; // indexed by {dy+1, dx+1}
+	bool const adj_same_source(using_hmap ? !add_detail : (mesh_gen_mode < MGEN_SIMPLEX_GPU && erosion_iters_tt == 0));
+
+	if (!use_ao_zvals && adj_same_source && !USE_PARAMS_HSCALE) {
+		for (int dy = -1; dy <= 1; ++dy) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				if (dx == 0 && dy == 0) continue;
+				tile_t const *const adj_tile(get_adj_tile(dx, dy));
+				if (adj_tile == NULL || adj_tile->is_distant || adj_tile->mesh_height_invalid || adj_tile->size != size || adj_tile->zvals.size() != zvals.size()) continue;
+				adj_zvals[dy+1][dx+1] = adj_tile->zvals.data();
+			}
+		}
+	}
 	if (use_ao_zvals) {czv.swap(ao_zvals);} // use precomputed values, will clear ao_zvals at the end
 	else {
 		czv.resize(context_sz*context_sz);
@@ -606,7 +741,10 @@ void tile_t::calc_mesh_ao_lighting() {
 				for (int x = 0; x < (int)context_sz; ++x) {
 					int const xv(x - AO_RAY_LEN), yv(y - AO_RAY_LEN);
 					float &zv(czv[y*context_sz + x]);
-					if (xv >= 0 && yv >= 0 && xv < (int)zvsize && yv < (int)zvsize) {zv = zvals[yv*zvsize + xv];}
+					if (xv >= 0 && yv >= 0 && xv < (int)zvsize && yv < (int)zvsize) {zv = zvals[yv*zvsize + xv]; continue;}
+					int const dx((xv < 0) ? -1 : ((xv >= (int)zvsize) ? 1 : 0)), dy((yv < 0) ? -1 : ((yv >= (int)zvsize) ? 1 : 0));
+					float const *const azv(adj_zvals[dy+1][dx+1]);
+					if (azv) {zv = azv[(yv - dy*int(size))*zvsize + (xv - dx*int(size))];} // shared with adjacent tile
 					else if (using_hmap) {
 						zv = terrain_hmap_manager.get_clamped_height((x1 + xv), (y1 + yv));
 						if (add_detail) {zv += HMAP_DETAIL_MAG*height_gen.eval_index(x, y);}
@@ -615,33 +753,37 @@ void tile_t::calc_mesh_ao_lighting() {
 				}
 			}
 		}
-		// calculate ao_lighting values by casting rays through the mesh zvals
+		// calculate ao_lighting values by casting rays through the mesh zvals; each ray step is applied to a full row at once for better vectorization
+		vector<float> z0(stride);
+		vector<unsigned> atten(stride);
+		vector<unsigned char> done(stride);
+
 #pragma omp for schedule(static,1)
 		for (int y = 0; y < (int)stride; ++y) {
-			for (int x = 0; x < (int)stride; ++x) {
-				unsigned atten(0);
-
-				for (unsigned d = 0; d < NUM_AO_DIRS; ++d) {
-					float z0(zvals[y*zvsize + x]);
-					tile_xy_pair step(ao_dirs[d]);
-					tile_xy_pair v(x, y);
-
-					for (unsigned s = 0; s < NUM_AO_STEPS; ++s) {
-						v    += step;
-						z0   += dz;
-						//step += step; // multiply by 2 for exponential step size
-						step += ao_dirs[d]; // linear increase (Note: must agree with max_ray_length)
-						int const xv(v.x + AO_RAY_LEN), yv(v.y + AO_RAY_LEN);
-						//assert(xv >= 0 && yv >= 0 && xv < (int)context_sz && yv < (int)context_sz);
-						
-						if (czv[yv*context_sz + xv] > z0) { // hit a higher point
-							atten += (NUM_AO_STEPS - s); // Note: ambient obscurance - uses actual distance to occluder
-							break;
-						}
-					} // for s
-				} // for d
-				assert(atten <= NUM_AO_DIRS*NUM_AO_STEPS);
-				float const ao_scale(1.0 - float(atten)/float(NUM_AO_DIRS*NUM_AO_STEPS));
+			float const *const row_zvals(zvals.data() + y*zvsize);
+			for (unsigned x = 0; x < stride; ++x) {atten[x] = 0;}
+
+			for (unsigned d = 0; d < NUM_AO_DIRS; ++d) {
+				for (unsigned x = 0; x < stride; ++x) {z0[x] = row_zvals[x]; done[x] = 0;}
+				tile_xy_pair step(ao_dirs[d]), v(0, y);
+
+				for (unsigned s = 0; s < NUM_AO_STEPS; ++s) {
+					v    += step;
+					step += ao_dirs[d]; // linear increase (Note: must agree with max_ray_length)
+					unsigned const atten_val(NUM_AO_STEPS - s); // Note: ambient obscurance - uses actual distance to occluder
+					float const *const czv_row(czv.data() + (v.y + AO_RAY_LEN)*context_sz + (v.x + AO_RAY_LEN)); // offset to x=0
+					
+					for (unsigned x = 0; x < stride; ++x) {
+						z0[x] += dz;
+						bool const hit(!done[x] && czv_row[x] > z0[x]); // hit a higher point
+						atten[x] += (hit ? atten_val : 0);
+						done [x] |= hit;
+					}
+				} // for s
+			} // for d
+			for (unsigned x = 0; x < stride; ++x) {
+				assert(atten[x] <= NUM_AO_DIRS*NUM_AO_STEPS);
+				float const ao_scale(1.0 - float(atten[x])/float(NUM_AO_DIRS*NUM_AO_STEPS));
 				ao_lighting[y*stride + x] = (unsigned char)(255.0*ao_scale);
 			} // for x
 		} // for y
@@ -709,6 +851,85 @@ void tile_t::proc_tile_queue(tile_t *init_tile, unsigned l) {
 }
 
 
+// computes missing shadows for light l for seeds and all tiles they pull from (toward the light), in parallel wavefronts moving away from the light;
+// tiles on the same anti-diagonal don't depend on each other, so the results are the same as the recursive serial calculation
+/*static*/ void tile_t::calc_shadows_wavefront(vector<tile_t *> const &seeds, unsigned l) {
+
+	unsigned const min_wavefront_tiles = 4; // use the serial path for fewer tiles than this
+	point const lpos(get_light_pos(l));
+	int const dx((lpos.x < 0.0) ? -1 : 1), dy((lpos.y < 0.0) ? -1 : 1); // toward the light source
+	vector<tile_t *> to_calc; // in_queue marks tiles that are in to_calc
+
+	for (tile_t *t : seeds) {
+		if (t->is_distant || !t->smask[l].empty() || t->in_queue) continue;
+		t->in_queue = 1;
+		to_calc.push_back(t);
+	}
+	unsigned const num_seeds(to_calc.size());
+
+	for (unsigned i = 0; i < to_calc.size(); ++i) { // add tiles closer to the light that we pull from; Note: to_calc grows in this loop
+		tile_xy_pair const tp(to_calc[i]->get_tile_xy_pair());
+		tile_xy_pair const adj_tp[2] = {tile_xy_pair((tp.x + dx), tp.y), tile_xy_pair(tp.x, (tp.y + dy))};
+
+		for (unsigned d = 0; d < 2; ++d) {
+			tile_t *adj_tile(get_tile_from_xy(adj_tp[d]));
+			if (adj_tile == NULL || adj_tile->is_distant || !adj_tile->smask[l].empty() || adj_tile->in_queue) continue;
+			adj_tile->in_queue = 1;
+			to_calc.push_back(adj_tile);
+		}
+	}
+	if (to_calc.size() < min_wavefront_tiles) { // not worth it; let calc_shadows() handle these tiles
+		for (tile_t *t : to_calc) {t->in_queue = 0;}
+		return;
+	}
+	//timer_t timer("Shadow Wavefront"); // report vs. OMP_NUM_THREADS
+	vector<vector<float>> prev_sh_out(2*num_seeds);
+
+	for (unsigned i = 0; i < num_seeds; ++i) {
+		for (unsigned d = 0; d < 2; ++d) {prev_sh_out[2*i + d] = to_calc[i]->sh_out[l][d];}
+	}
+	vector<pair<int, tile_t *>> waves; // {-wavefront index, tile}: sorted closest to the light first
+
+	for (tile_t *t : to_calc) {
+		tile_xy_pair const tp(t->get_tile_xy_pair());
+		waves.emplace_back(-(dx*tp.x + dy*tp.y), t);
+	}
+	sort(waves.begin(), waves.end());
+	unsigned num_waves(0);
+
+	for (unsigned start = 0; start < waves.size(); ++num_waves) {
+		unsigned end(start+1);
+		while (end < waves.size() && waves[end].first == waves[start].first) {++end;}
+
+#pragma omp parallel for schedule(dynamic,1)
+		for (int i = start; i < (int)end; ++i) {
+			tile_t *const t(waves[i].second);
+			t->smask[l].resize(t->zvals.size(), 0);
+			t->calc_shadows_for_light(l); // inputs were calculated in a previous wavefront
+		}
+		start = end;
+	} // for start
+	if (DEBUG_TILES) {cout << "shadow wavefront: " << to_calc.size() << " tiles, " << num_waves << " waves" << endl;}
+	// the serial algorithm pushes updates from seed tiles to initialized tiles away from the light if the seed's outputs change
+	vector<tile_t *> to_push;
+
+	for (unsigned i = 0; i < num_seeds; ++i) {
+		tile_t const *const t(to_calc[i]);
+		tile_xy_pair const tp(t->get_tile_xy_pair());
+		tile_xy_pair const adj_tp2[2] = {tile_xy_pair((tp.x - dx), tp.y), tile_xy_pair(tp.x, (tp.y - dy))}; // away from the light source
+
+		for (unsigned d = 0; d < 2; ++d) {
+			if (t->sh_out[l][!d] == prev_sh_out[2*i + !d]) continue; // unchanged, no update needed
+			tile_t *adj_tile(get_tile_from_xy(adj_tp2[d]));
+			if (adj_tile == NULL || adj_tile->is_distant || adj_tile->smask[l].empty() || adj_tile->in_queue) continue; // no adjacent tile, not initialized, or just calculated
+			to_push.push_back(adj_tile);
+		}
+	}
+	for (tile_t *t : to_calc) {t->in_queue = 0;}
+	for (tile_t *t : to_push) {proc_tile_queue(t, l);}
+}
+
+
 void tile_t::calc_shadows(bool calc_sun, bool calc_moon, bool no_push) {
 
 	bool calc_light[NUM_LIGHT_SRC] = {0};
@@ -2197,7 +2418,10 @@ void tile_draw_t::clear(bool no_regen_buildings) {
 	clear_vbos_tids(); // needed to clear vbo, ivbo, and free list
 	for (tile_map::iterator i = tiles.begin(); i != tiles.end(); ++i) {i->second->clear();} // may not be necessary
 	to_draw.clear();
+	to_gen_zvals.clear(); // owned by pending_tiles
 	tiles.clear();
+	pending_tiles.clear();
+	tile_cache.clear(); // mesh may have changed
 	shadow_recomp_queue.clear();
 	if (!no_regen_buildings && !have_cities()) {buildings_valid = 0;} // can't regenerate buildings after cities and cars have been placed
 }
@@ -2206,6 +2430,13 @@ void tile_draw_t::insert_tile(tile_t *tile) {
 	bool const did_ins(tiles.insert(make_pair(tile->get_tile_xy_pair(), tile)).second);
 	assert(did_ins);
 }
+void tile_draw_t::insert_pending_tile(tile_t *tile) { // moves ownership from pending_tiles to tiles
+	auto it(pending_tiles.find(tile->get_tile_xy_pair()));
+	assert(it != pending_tiles.end() && it->second.get() == tile);
+	it->second.release();
+	pending_tiles.erase(it);
+	insert_tile(tile);
+}
 
 void tile_draw_t::free_compute_shader() {
 	for (auto i = height_gens.begin(); i != height_gens.end(); ++i) {i->clear_context();}
@@ -2217,6 +2448,7 @@ float tile_draw_t::update(float &min_camera_dist) { // view-independent updates;
 	unsigned const max_tile_gen_per_frame = 16; // higher = less overall gen time (more parallel), but longer wait for first render
 	unsigned const max_cpu_tiles          = 3; // 0 = GPU only
 	unsigned const max_defer_tiles        = 8; // 0 = disable
+	int      const max_tile_gen_time_ms   = 8; // CPU gen time budget per frame once some tiles are drawn; 0 = unlimited
 	if (height_gens.empty()) {height_gens.resize(max(max_defer_tiles, 1U));}
 
 	if (terrain_hmap_manager.maybe_load(mh_filename_tt, (invert_mh_image != 0))) {
@@ -2255,30 +2487,36 @@ float tile_draw_t::update(float &min_camera_dist) { // view-independent updates;
 		for (unsigned i = 0; i < to_gen_zvals.size(); ++i) { // tiles were waiting on zval generation (async)
 			tile_t *tile(to_gen_zvals[i].second);
 			tile->create_zvals(height_gens[i], 0); // wait for zvals to be generated
-			insert_tile(tile); // zvals have been generated
+			insert_pending_tile(tile); // zvals have been generated
 		}
 		to_gen_zvals.clear();
 	}
 	for (tile_map::iterator i = tiles.begin(); i != tiles.end(); ) { // update tiles and free old tiles (Note: no ++i)
 		if (!i->second->update_range(smap_manager)) { // delete this tile
 			remove_buildings_tile(i->first.x, i->first.y); // required to avoid memory leak when player teleports to a new location
+			if (!create_buildings_first) {tile_cache.add(i->first, *i->second);} // can't cache if buildings flatten the heightmap when tiles are created
 			i->second->clear();
 			tiles.erase(i++);
 			++num_erased;
 		} else {++i;}
 	}
+	for (tile_map::iterator i = pending_tiles.begin(); i != pending_tiles.end(); ) { // cancel pending tiles the camera has moved away from (Note: no ++i)
+		if (!i->second->rel_dist_to_camera_xy_lt(CREATE_DIST_TILES)) {pending_tiles.erase(i++);} else {++i;}
+	}
 	for (int y = y1; y <= y2; ++y ) { // create new tiles
 		for (int x = x1; x <= x2; ++x ) {
 			tile_xy_pair const txy(x, y);
-			if (tiles.find(txy) != tiles.end()) continue; // already exists
+			if (tiles.find(txy) != tiles.end() || pending_tiles.find(txy) != pending_tiles.end()) continue; // already exists or queued
 			tile_t tile(get_tile_size(), x, y);
 			if (!tile.rel_dist_to_camera_xy_lt(CREATE_DIST_TILES)) continue; // too far away to create
 			tile_t *new_tile(new tile_t(tile));
-			to_gen_zvals.push_back(make_pair(new_tile->get_draw_priority(), new_tile));
+			if (!create_buildings_first && tile_cache.lookup(txy, *new_tile)) {insert_tile(new_tile); continue;} // revisited tile; zvals were restored from the cache
+			pending_tiles.emplace(txy, new_tile);
 			// in this mode, we need to place buildings and flatten the heightmap before calculating tile heights
 			if (create_buildings_first) {create_buildings_tile(x, y, 1);}
 		} // for x
 	} // for y
+	for (auto const &t : pending_tiles) {to_gen_zvals.push_back(make_pair(t.second->get_draw_priority(), t.second.get()));} // re-prioritize for the current camera
 	//if (to_gen_zvals.size() < max_cpu_tiles) {to_gen_zvals.clear();} // block until at least max_cpu_tiles tiles to generate (lower average gen time, but causes more slow frames/lag)
 	unsigned const num_to_gen(to_gen_zvals.size());
 	unsigned gen_this_frame(min(num_to_gen, max_tile_gen_per_frame));
@@ -2298,7 +2536,7 @@ float tile_draw_t::update(float &min_camera_dist) { // view-independent updates;
 
 		for (unsigned i = 0; i < num_to_gen; ++i) {
 			tile_t *tile(to_gen_zvals[i].second);
-			if (tile->create_zvals(height_gens[i], 1)) {insert_tile(tile);} // no_wait=1; zvals have been generated, insert tile and remove from to_gen_zvals
+			if (tile->create_zvals(height_gens[i], 1)) {insert_pending_tile(tile);} // no_wait=1; zvals have been generated, insert tile and remove from to_gen_zvals
 			else {to_gen_zvals[i] = to_gen_zvals[tgz_pos++];} // zvals are not ready, leave in to_gen_zvals and try again during the next update
 		}
 		to_gen_zvals.resize(tgz_pos);
@@ -2308,12 +2546,15 @@ float tile_draw_t::update(float &min_camera_dist) { // view-independent updates;
 		int const prev_mesh_gen_mode(mesh_gen_mode);
 		if (gpu_mode && gen_this_frame <= max_cpu_tiles) {mesh_gen_mode = MGEN_SIMPLEX;} // GPU simplex => CPU simplex
 		if (gen_this_frame < num_to_gen) {sort(to_gen_zvals.begin(), to_gen_zvals.end());} // sort by priority if not all generated
+		// limit CPU gen time per frame to avoid spikes when flying fast; skip the limit for the initial tiles and when editing mesh height
+		bool const use_time_budget(max_tile_gen_time_ms > 0 && !tiles.empty() && inf_terrain_fire_mode == FM_NONE);
+		int const gen_start_time(GET_TIME_MS());
 
-		for (unsigned i = 0; i < num_to_gen; ++i) {
+		for (unsigned i = 0; i < gen_this_frame; ++i) { // remaining tiles stay in pending_tiles for a later frame
+			if (use_time_budget && i > 0 && (GET_TIME_MS() - gen_start_time) > max_tile_gen_time_ms) break; // out of time
 			tile_t *tile(to_gen_zvals[i].second);
-			if (i >= gen_this_frame) {delete tile; continue;} // delete these tiles - they will be created in a later frame
 			tile->create_zvals(height_gens[0], 0); // generate these tiles
-			insert_tile(tile);
+			insert_pending_tile(tile);
 		}
 		to_gen_zvals.clear();
 		mesh_gen_mode = prev_mesh_gen_mode;
@@ -2622,6 +2863,7 @@ uint64_t tile_draw_t::show_debug_stats(bool calc_mem_only) const {
 		<< ", grass MB: " << in_mb(grass_mem) << ", smap MB: " << in_mb(smap_mem) << ", smap free list MB: " << in_mb(smap_free_list_mem)
 		<< ", dlights smap mem MB: " << in_mb(dlights_smap_mem) << ", frame buf MB: " << in_mb(frame_buf_mem) << ", texture MB: " << in_mb(texture_mem)
 		<< ", building MB: " << in_mb(building_mem) << ", room_geom MB: " << in_mb(room_geom_mem) << ", model MB: " << in_mb(models_mem) << endl;
+	tile_cache.print_stats();
 	//show_gpu_mem_info(); // shows total and available video memory
 	return tot_mem;
 }
@@ -2690,6 +2932,11 @@ void tile_draw_t::pre_draw() { // view-dependent updates/GPU uploads
 		}
 	} // for i
 	if (enable_instanced_pine_trees() && !to_gen_trees.empty()) {create_pine_tree_instances();}
+
+	if (mesh_shadows_enabled()) { // calculate missing mesh shadows for all tiles to update in parallel rather than recursively in tile_t::pre_draw()
+		if (light_factor >= 0.4) {tile_t::calc_shadows_wavefront(to_update, LIGHT_SUN );}
+		if (light_factor <= 0.6) {tile_t::calc_shadows_wavefront(to_update, LIGHT_MOON);}
+	}
 	//RESET_TIME;
 	// don't use parallel tree gen for a single tile or when using GPU noise
 	bool const use_mt(to_gen_trees.size() > 1 && mesh_gen_mode != MGEN_SIMPLEX_GPU && mesh_gen_mode != MGEN_DWARP_GPU);
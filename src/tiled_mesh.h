@@ -267,6 +267,7 @@ public:
 		return cube_t(xv1, xv1+(x2-x1)*deltax, yv1, yv1+(y2-y1)*deltay, mzmin, mzmax);
 	}
 	void fill_adj_mask(bool mask[3][3], int x, int y) const;
+	void fill_adj_mask_span(bool mask[3][3], int xa, int xb, int y) const;
 	float get_min_dist_to_pt(point const &pt, bool xy_only=0, bool mesh_only=1) const;
 	float get_max_xy_dist_to_pt(point const &pt) const;
 	bool contains_point(point const &pos) const {return get_bcube().contains_pt_xy(pos);} // XY only
@@ -294,10 +295,27 @@ public:
 	vector3d get_norm(unsigned ix) const {return get_norm_not_normalized(ix).get_norm();}
 	vector3d get_mesh_xlate() const {return mesh_off.get_xlate() + vector3d(xstart, ystart, 0.0);}
 
+	// *** evicted tile cache ***
+	struct cached_data_t { // results of create_zvals() and calc_mesh_ao_lighting()
+		vector<float> zvals;
+		vector<unsigned char> ao_lighting;
+		terrain_params_t params[2][2];
+		float sub_zmin[4][4] = {0}, sub_zmax[4][4] = {0};
+		float radius=0, mzmin=0, mzmax=0, mesh_dz=0;
+		int wx1=0, wy1=0, wx2=0, wy2=0, inside_city=0;
+		unsigned size=0, gen_params_hash=0; // tile must be regenerated if the hash of global generation params changes
+		bool no_trees=0;
+		size_t get_mem() const {return (zvals.size()*sizeof(float) + ao_lighting.size()*sizeof(unsigned char));}
+	};
+	bool can_cache() const {return (!zvals.empty() && !is_distant && !mesh_height_invalid);}
+	void save_cached_data(cached_data_t &data) const;
+	bool restore_cached_data(cached_data_t const &data);
+
 	// *** shadows ***
 	void calc_mesh_ao_lighting();
 	void calc_shadows_for_light(unsigned l);
 	static void proc_tile_queue(tile_t *init_tile, unsigned l);
+	static void calc_shadows_wavefront(vector<tile_t *> const &seeds, unsigned l);
 	void calc_shadows(bool calc_sun, bool calc_moon, bool no_push=0);
 
 	tile_xy_pair get_tile_xy_pair(int dx=0, int dy=0) const {
@@ -424,7 +442,7 @@ class tile_draw_t : public indexed_vbo_manager_t {
 	typedef unordered_map<tile_xy_pair, unique_ptr<tile_t>, hash_tile_xy_pair> tile_map;
 	typedef vector<pair<float, tile_t *> > draw_vect_t;
 
-	tile_map tiles;
+	tile_map tiles, pending_tiles; // pending_tiles are waiting for zval generation and persist across frames until generated or out of range
 	bool buildings_valid=0;
 	unsigned ivbo_ixs[NUM_LODS+1] = {0};
 	unsigned tiles_gen_prev_frame=0;
@@ -453,6 +471,7 @@ class tile_draw_t : public indexed_vbo_manager_t {
 	vector<occluder_cubes_t> occluders; // reused across draw calls
 	vector<unsigned> occluder_ixs; // reused across draw calls
 	void insert_tile(tile_t *tile);
+	void insert_pending_tile(tile_t *tile);
 
 public:
 	tile_draw_t();
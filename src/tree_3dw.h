@@ -112,9 +112,10 @@ struct tree_xform_t {
 
 class tree_builder_t : public tree_xform_t {
 
-	static vector<tree_cylin >   cylin_cache;
-	static vector<tree_branch>   branch_cache;
-	static vector<tree_branch *> branch_ptr_cache;
+	// per-thread scratch space, so that multiple trees can be generated in parallel
+	static thread_local vector<tree_cylin >   cylin_cache;
+	static thread_local vector<tree_branch>   branch_cache;
+	static thread_local vector<tree_branch *> branch_ptr_cache;
 
 	tree_branch base, roots, *branches_34[2]={}, **branches=nullptr;
 	int base_num_cylins=0, root_num_cylins=0, ncib=0, num_1_branches=0, num_big_branches_min=0, num_big_branches_max=0;
@@ -167,7 +168,7 @@ class tree_data_t {
 	texture_pair_t render_leaf_texture, render_branch_texture;
 	int last_update_frame=0;
 	unsigned leaf_change_start=0, leaf_change_end=0;
-	bool reset_leaves=0, has_4th_branches=0;
+	bool reset_leaves=0, has_4th_branches=0, gen_pending=0;
 
 	void clear_vbo_ixs();
 	template<typename branch_index_t> void create_branch_vbo();
@@ -190,7 +191,8 @@ public:
 	void update_leaf_color(unsigned i, bool no_mark_changed=0);
 	colorRGB get_leaf_color(unsigned i) const;
 	bool leaf_data_allocated() const {return !leaf_data.empty();}
-	bool is_created() const {return !all_cylins.empty();} // as good a check as any
+	bool is_created() const {return (!all_cylins.empty() || gen_pending);} // as good a check as any
+	void set_gen_pending(int tree_type_) {tree_type = tree_type_; gen_pending = 1;} // will be generated later by a tree_gen_job_t
 	bool leaf_vbo_valid() const {return (leaf_vbo > 0);}
 	bool get_has_4th_branches() const {return has_4th_branches;}
 	float get_size_scale_mult() const;
@@ -258,6 +260,17 @@ public:
 };
 
 
+// deferred call to tree_data_t::gen_tree_data() for a tree, so that tree data can be generated in parallel after tree placement
+struct tree_gen_job_t {
+	unsigned tree_ix=0;
+	int type=0, size=0;
+	float tree_depth=0.0, height_scale=1.0, br_scale=1.0, nl_scale=1.0, bbo_scale=1.0;
+	bool has_4th_branches=0, create_bush=0, use_clip_cube=0;
+	cube_t clip_cube;
+	rand_gen_t rgen; // state at the point where the tree data would have been generated
+};
+
+
 class tree {
 
 	tree_data_t priv_tree_data;
@@ -300,7 +313,10 @@ public:
 	void enable_clip_cube(cube_t const &cc) {clip_cube = cc; use_clip_cube = 1;}
 	void bind_to_td(tree_data_t *td);
 	void gen_tree(point const &pos, int size, int ttype, int calc_z, bool add_cobjs, bool user_placed, rand_gen_t &rgen,
-		float height_scale=1.0, float br_scale_mult=1.0, float nl_scale=1.0, bool has_4th_branches=0, bool allow_bushes=1, bool force_bushes=0);
+		float height_scale=1.0, float br_scale_mult=1.0, float nl_scale=1.0, bool has_4th_branches=0, bool allow_bushes=1, bool force_bushes=0,
+		vector<tree_gen_job_t> *gen_jobs=nullptr);
+	void run_gen_job(tree_gen_job_t const &job);
+	void finish_gen_tree(bool add_cobjs);
 	void add_tree_collision_objects();
 	void remove_collision_objects();
 	bool check_sphere_coll(point &center, float radius) const;
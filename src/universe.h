@@ -9,6 +9,7 @@
 #include "gl_ext_arb.h"
 #include <map>
 #include <sstream>
+#include <atomic>
 
 using std::string;
 using std::ostringstream;
@@ -147,14 +148,24 @@ public:
 class uobj_rgen: public uobject { // size = 64
 
 public:
-	char gen;
+	std::atomic<char> gen; // written by the generating thread and read concurrently by other threads
 	rand_gen_t rgen;
 
 	uobj_rgen() : gen(0) {}
+	uobj_rgen(uobj_rgen const &o) : uobject(o), gen(o.gen.load(std::memory_order_relaxed)), rgen(o.rgen) {} // std::atomic isn't copyable
+	uobj_rgen &operator=(uobj_rgen const &o) {
+		uobject::operator=(o);
+		gen.store(o.gen.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		rgen = o.rgen;
+		return *this;
+	}
 	void gen_rseeds();
 	void get_rseeds();
 	void set_rseeds() const;
 	int get_id() const {return rgen.rseed1;} // not complete id, but should be good enough
+	// gen is published last so that a concurrent reader that sees gen=1 also sees the generated children
+	void publish_gen() {gen.store(1, std::memory_order_release);}
+	bool is_gen() const {return (gen.load(std::memory_order_acquire) != 0);}
 };
 
 
@@ -227,6 +238,7 @@ public:
 	void create_rocky_texture(unsigned size);
 	void create_gas_giant_texture();
 	void gen_texture_data_and_heightmap(unsigned char *data, unsigned size);
+	void calc_texture_data_and_heightmap(unsigned char *data, unsigned size, unsigned num_sines, vector<float> &hmap);
 	bool has_heightmap() const {return (surface != nullptr && surface->has_heightmap() && !use_procedural_shader());}
 	bool surface_test(float rad, point const &p, float &coll_r, bool simple) const;
 	float get_radius_at(point const &p, bool exact=0) const;
@@ -560,11 +572,19 @@ struct line_query_state {
 class universe_t : protected cell_block {
 
 	icosphere_manager_t planet_manager;
-	cell_block temp; // used for shift_cells
+	unsigned cell_off[3]={}; // cells are a ring buffer in each dim: logical cell i is stored at (i + cell_off)%U_BLOCKS
+	bool cells_shifted=0;
 
+	ucell const &get_cell_xyz(unsigned x, unsigned y, unsigned z) const {
+		return cells[(z + cell_off[2])%U_BLOCKS][(y + cell_off[1])%U_BLOCKS][(x + cell_off[0])%U_BLOCKS];
+	}
+	ucell &get_cell_xyz(unsigned x, unsigned y, unsigned z) {
+		return cells[(z + cell_off[2])%U_BLOCKS][(y + cell_off[1])%U_BLOCKS][(x + cell_off[0])%U_BLOCKS];
+	}
 public:
 	void init();
 	void shift_cells(int dx, int dy, int dz);
+	unsigned prefetch_galaxies(point const &camera, vector3d const &dir, unsigned max_galaxies);
 	void free_context();
 	void draw_all_cells(s_object const &clobj, bool skip_closest, bool no_move, int no_distant, bool gen_only, bool no_asteroid_dust);
 	int get_closest_object(s_object &result, point pos, int max_level, bool include_asteroids, bool offset, float expand,
@@ -586,17 +606,34 @@ public:
 	}
 	ucell const &get_cell(int const cxyz[3]) const {
 		assert(!bad_cell_xyz(cxyz));
-		return cells[cxyz[2]][cxyz[1]][cxyz[0]];
+		return get_cell_xyz(cxyz[0], cxyz[1], cxyz[2]);
 	}
 	ucell &get_cell(int const cxyz[3]) {
 		assert(!bad_cell_xyz(cxyz));
-		return cells[cxyz[2]][cxyz[1]][cxyz[0]];
+		return get_cell_xyz(cxyz[0], cxyz[1], cxyz[2]);
 	}
 	ucell const &get_cell(s_object const &so) const {return get_cell(so.cellxyz);}
 	ucell       &get_cell(s_object const &so)       {return get_cell(so.cellxyz);}
 };
 
 
+// defers freeing of systems and planets while another thread (ship processing) may still hold references to them;
+// frees are queued between begin_epoch() and end_epoch(), and end_epoch() must be called after all readers have finished
+class uobj_reclaimer_t {
+
+	bool in_epoch=0;
+	vector<uplanet *> planets;
+	vector<ussystem *> system_planets, systems;
+
+public:
+	void begin_epoch() {assert(!in_epoch); in_epoch = 1;}
+	void end_epoch();
+	void free_planet(uplanet &planet);
+	void free_system_planets(ussystem &sol);
+	void free_system(ussystem &sol);
+};
+
+
 typedef string modmap_val_t;
 typedef map<s_object, modmap_val_t> modmap;
 
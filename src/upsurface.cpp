@@ -10,10 +10,92 @@
 
 float const M_ATTEN_FACTOR = 0.5;
 float const F_ATTEN_FACTOR = 0.4;
+size_t const SURFACE_CACHE_MAX_MEM = 64 << 20; // 64MB
+bool const VERIFY_SURFACE_CACHE    = 0; // regenerate on cache hits and compare
+bool const PRINT_SURFACE_CACHE_STATS = 0;
 
 extern int display_mode;
 
 
+// caches generated rocky planet/moon texture data and heightmaps so that revisiting a body or switching between texture size tiers doesn't regenerate them;
+// the key includes the exact bits of every body parameter that affects the generated data, so a hit is byte-identical to direct generation
+class surface_data_cache_t {
+
+	struct key_t {
+		int rseed1, rseed2, type;
+		unsigned size;
+		vector<unsigned> params;
+
+		bool operator<(key_t const &k) const {
+			if (rseed1 != k.rseed1) return (rseed1 < k.rseed1);
+			if (rseed2 != k.rseed2) return (rseed2 < k.rseed2);
+			if (type   != k.type  ) return (type   < k.type  );
+			if (size   != k.size  ) return (size   < k.size  );
+			return (params < k.params);
+		}
+	};
+	struct entry_t {
+		vector<unsigned char> data;
+		vector<float> hmap;
+		unsigned last_used=0;
+		size_t get_mem() const {return (data.size()*sizeof(unsigned char) + hmap.size()*sizeof(float));}
+	};
+	map<key_t, entry_t> entries;
+	size_t mem_usage=0;
+	unsigned use_counter=0, num_hits=0, num_misses=0;
+
+	void evict_lru() {
+		assert(!entries.empty());
+		auto lru(entries.begin());
+
+		for (auto i = entries.begin(); i != entries.end(); ++i) {
+			if (i->second.last_used < lru->second.last_used) {lru = i;}
+		}
+		mem_usage -= lru->second.get_mem();
+		entries.erase(lru);
+	}
+public:
+	static key_t make_key(urev_body const &body, unsigned size, float const *params, unsigned num_params) {
+		key_t key;
+		key.rseed1 = body.rgen.rseed1;
+		key.rseed2 = body.rgen.rseed2;
+		key.type   = body.type;
+		key.size   = size;
+		key.params.resize(num_params);
+		static_assert(sizeof(float) == sizeof(unsigned), "float/unsigned size mismatch");
+		memcpy(key.params.data(), params, num_params*sizeof(float));
+		return key;
+	}
+	bool lookup(key_t const &key, unsigned char *data, vector<float> &hmap) {
+		auto it(entries.find(key));
+		if (it == entries.end()) {++num_misses; return 0;}
+		entry_t &e(it->second);
+		assert(e.hmap.size() == hmap.size());
+		memcpy(data, e.data.data(), e.data.size());
+		hmap = e.hmap;
+		e.last_used = ++use_counter;
+		++num_hits;
+		return 1;
+	}
+	void add(key_t const &key, unsigned char const *data, unsigned data_sz, vector<float> const &hmap) {
+		entry_t e;
+		e.data.assign(data, data+data_sz);
+		e.hmap = hmap;
+		e.last_used = ++use_counter;
+		if (e.get_mem() > SURFACE_CACHE_MAX_MEM) return; // too large to cache
+		while (mem_usage + e.get_mem() > SURFACE_CACHE_MAX_MEM) {evict_lru();}
+		mem_usage += e.get_mem();
+		entries[key] = std::move(e);
+	}
+	void print_stats() const {
+		cout << "Surface cache: entries: " << entries.size() << ", MB: " << (mem_usage >> 20) << ", hits: " << num_hits << ", misses: " << num_misses
+			 << ", hit rate: " << ((num_hits + num_misses) ? 100.0*num_hits/(num_hits + num_misses) : 0.0) << "%" << endl;
+	}
+};
+
+surface_data_cache_t surface_data_cache;
+
+
 void noise_gen_3d::gen_sines(float mag, float freq) {
 
 	assert(SINES_PER_FREQ >= 2);
@@ -128,14 +210,19 @@ void upsurface::setup(unsigned size, float mcut, bool alloc_hmap) {
 	ssize      = size;
 	min_cutoff = mcut;
 	if (alloc_hmap) heightmap.resize(ssize*ssize);
+	num_sines  = calc_num_sines(ssize);
+}
+
+unsigned upsurface::calc_num_sines(unsigned size) {
+
 	unsigned max_freq(MAX_FREQ_BINS - 4);
 
 	for (unsigned i = 8; i <= MAX_TEXTURE_SIZE; i <<= 1) {
-		if (ssize <= i) break;
+		if (size <= i) break;
 		++max_freq;
 	}
-	max_freq  = max(1u, min(MAX_FREQ_BINS, max_freq));
-	num_sines = max_freq*SINES_PER_FREQ;
+	max_freq = max(1u, min(MAX_FREQ_BINS, max_freq));
+	return max_freq*SINES_PER_FREQ;
 }
 
 
@@ -179,10 +266,12 @@ upsurface::~upsurface() {
 void urev_body::gen_surface() {
 
 	set_rseeds();
-	surface.reset(new upsurface(type)); // may delete a previous surface
+	p_upsurface new_surface(new upsurface(type));
 	float mag(SURFACE_HEIGHT*radius), freq(((type == UTYPE_MOON) ? 1.5 : 1.0)*INITIAL_FREQ*TWO_PI);
-	surface->rgen = rgen; // just copy it?
-	surface->gen(mag, freq);
+	new_surface->rgen = rgen; // just copy it?
+	new_surface->gen(mag, freq);
+#pragma omp critical(planet_surface)
+	surface.swap(new_surface); // ship collision queries may read the surface from the ship thread; previous surface (if any) is deleted below on this thread
 }
 
 
@@ -197,15 +286,47 @@ void urev_body::gen_texture_data_and_heightmap(unsigned char *data, unsigned siz
 	for (unsigned sz = size; sz > 1; sz >>= 1, ++size_p2);
 	assert((1U<<size_p2) == size); // size must be a power of 2
 	assert(surface != nullptr);
+	// the heightmap is generated into hmap and swapped in at the end, since ship collision queries may read the surface from the ship thread
+	unsigned const num_sines(upsurface::calc_num_sines(size));
+	vector<float> hmap(size*size);
+	wr_scale = 1.0/max(0.01, (1.0 - water));
+	// everything used by calc_texture_data_and_heightmap() and get_surface_color()
+	float const params[] = {float(a[0]), float(a[1]), float(a[2]), float(b[0]), float(b[1]), float(b[2]), water, lava, atmos, temp, snow_thresh, wr_scale,
+		radius, surface->max_mag, float(num_sines)};
+	auto const key(surface_data_cache_t::make_key(*this, size, params, sizeof(params)/sizeof(float)));
+	unsigned const data_sz(3*size*size);
+
+	if (surface_data_cache.lookup(key, data, hmap)) {
+		if (VERIFY_SURFACE_CACHE) {
+			vector<unsigned char> const cached_data(data, data+data_sz);
+			vector<float> const cached_hmap(hmap);
+			calc_texture_data_and_heightmap(data, size, num_sines, hmap);
+			assert(memcmp(data, cached_data.data(), data_sz) == 0 && hmap == cached_hmap);
+		}
+	}
+	else {
+		calc_texture_data_and_heightmap(data, size, num_sines, hmap);
+		surface_data_cache.add(key, data, data_sz, hmap);
+		if (PRINT_SURFACE_CACHE_STATS) {surface_data_cache.print_stats();}
+	}
+#pragma omp critical(planet_surface)
+	{
+		surface->setup(size, max(water, lava), 0); // use_heightmap=0; sets ssize and num_sines to match hmap
+		surface->heightmap.swap(hmap);
+	}
+	//if (size >= MAX_TEXTURE_SIZE) PRINT_TIME("Gen");
+}
+
+
+void urev_body::calc_texture_data_and_heightmap(unsigned char *data, unsigned size, unsigned num_sines, vector<float> &hmap) {
+
 	unsigned const table_size(MAX_TEXTURE_SIZE << 1); // larger is more accurate
-	static float xtable[TOT_NUM_SINES*table_size] = {}, ytable[TOT_NUM_SINES*table_size] = {};
-	surface->setup(size, max(water, lava), 1); // use_heightmap=1
-	unsigned const num_sines(surface->num_sines);
+	static float xtable[TOT_NUM_SINES*table_size] = {}, ytable[TOT_NUM_SINES*table_size] = {}; // only called from the drawing thread
+	assert(hmap.size() == size*size);
 	float const *const rdata(surface->rdata);
 	float const mt2(0.5*(table_size-1)), scale(1.5/surface->max_mag);
 	float const delta(TWO_PI/size), sin_ds(sin(delta)), cos_ds(cos(delta));
 	unsigned const pole_thresh(size>>3);
-	wr_scale = 1.0/max(0.01, (1.0 - water));
 
 	for (unsigned i = 0; i < table_size; ++i) { // build sin table
 		unsigned const offset(i*num_sines);
@@ -248,24 +369,25 @@ void urev_body::gen_texture_data_and_heightmap(unsigned char *data, unsigned siz
 				for (unsigned k = 0; k < num_sines; ++k) {val += ztable[k]*xtable[ox1+k]*ytable[oy1+k];}
 			}
 			val = 0.5*(max(-1.0f, min(1.0f, scale*val)) + 1.0);
-			surface->heightmap[hmoff + j] = val;
+			hmap[hmoff + j] = val;
 			get_surface_color((data + index), val, phi);
 			sin_s = s*cos_ds + c*sin_ds;
 			cos_s = c*cos_ds - s*sin_ds;
 		} // for j
 	} // for i
-	//if (size >= MAX_TEXTURE_SIZE) PRINT_TIME("Gen");
 }
 
 
 bool urev_body::surface_test(float rad, point const &p, float &coll_r, bool simple) const {
 
 	// not quite right - should take into consideration peaks in surrounding geometry that also intersect the sphere
+	bool ret(1);
+#pragma omp critical(planet_surface) // called from the ship thread while the drawing thread may be regenerating the surface
 	if (has_heightmap()) {
-		if (!dist_less_than(p, pos, (radius*(1.0 + 0.5*get_hmap_scale()) + rad))) return 0; // test rmax
-		coll_r = get_radius_at(p, !simple);
+		if (!dist_less_than(p, pos, (radius*(1.0 + 0.5*get_hmap_scale()) + rad))) {ret = 0;} // test rmax
+		else {coll_r = get_radius_at(p, !simple);}
 	}
-	return 1;
+	return ret;
 }
 
 
@@ -295,7 +417,10 @@ float urev_body::get_dheight_at(point const &p, bool exact) const {
 
 bool urev_body::pt_over_land(point const &p) const {
 
-	if (water < 0.1 || !has_heightmap()) return 1;
-	return (get_dheight_at(p, 1) > surface->min_cutoff);
+	if (water < 0.1) return 1;
+	bool ret(1);
+#pragma omp critical(planet_surface) // see surface_test()
+	if (has_heightmap()) {ret = (get_dheight_at(p, 1) > surface->min_cutoff);}
+	return ret;
 }
 
@@ -762,31 +762,21 @@ void voxel_manager::remove_unconnected_outside_range(bool keep_at_edge, unsigned
 {
 	//timer_t timer("Remove Unconnected");
 	assert(!outside.empty());
-	vector<unsigned> &work(temp_work); // stack of voxels to process
-	assert(work.empty());
 
-	if (params.atten_sphere_mode() || !use_mesh) { // sphere mode / not mesh mode
-		unsigned const x(nx/2), y(ny/2); // add a single point at the center of the sphere (will only work for filled sphere center)
-
-		if (x >= x1 && x <= x2 && y >= y1 && y <= y2) {
-			unsigned const ix(outside.get_ix(x, y, nz/2));
-			assert(outside[ix] != UNDER_MESH_BIT); // outside or above mesh
-			work.push_back(ix); // inside, anchored to the mesh
-			outside[ix] |= ANCHORED_BIT; // mark as anchored
-		}
+	if (!params.atten_sphere_mode() && use_mesh) { // mesh mode: anchored to voxels along the mesh surface
+		remove_unconnected_outside_range_mesh(keep_at_edge, x1, y1, x2, y2, xy_updated, updated_pts, mark_only);
+		return;
 	}
-	else { // add voxels along the mesh surface
-		for (unsigned y = y1; y < y2; ++y) {
-			for (unsigned x = x1; x < x2; ++x) {
-				unsigned ix(outside.get_ix(x, y, 0));
+	vector<unsigned> &work(temp_work); // stack of voxels to process
+	assert(work.empty());
+	// sphere mode / not mesh mode
+	unsigned const xc(nx/2), yc(ny/2); // add a single point at the center of the sphere (will only work for filled sphere center)
 
-				for (unsigned ix_end = ix + nz; ix < ix_end; ++ix) {
-					if (outside[ix] != UNDER_MESH_BIT) continue; // outside or above mesh
-					work.push_back(ix); // inside, anchored to the mesh
-					outside[ix] |= ANCHORED_BIT; // mark as anchored
-				}
-			}
-		}
+	if (xc >= x1 && xc <= x2 && yc >= y1 && yc <= y2) {
+		unsigned const ix(outside.get_ix(xc, yc, nz/2));
+		assert(outside[ix] != UNDER_MESH_BIT); // outside or above mesh
+		work.push_back(ix); // inside, anchored to the mesh
+		outside[ix] |= ANCHORED_BIT; // mark as anchored
 	}
 
 	// add voxels along the scene x/y boundary
@@ -829,6 +819,85 @@ void voxel_manager::remove_unconnected_outside_range(bool keep_at_edge, unsigned
 }
 
 
+// Same result as flood filling from the anchor voxels (under mesh, or at the range edge if keep_at_edge), but operates on vertical runs of
+// inside/anchor voxels in each x/y column: runs that overlap in adjacent columns are joined with union-find, and any inside voxels
+// in a set of runs without an anchor voxel are unconnected; this avoids pushing every voxel under the mesh onto the flood fill stack
+void voxel_manager::remove_unconnected_outside_range_mesh(bool keep_at_edge, unsigned x1, unsigned y1, unsigned x2, unsigned y2,
+	vector<unsigned> *xy_updated, vector<pt_ix_t> *updated_pts, bool mark_only)
+{
+	assert(x1 <= x2 && y1 <= y2 && x2 <= nx && y2 <= ny);
+	unsigned const w(x2 - x1), h(y2 - y1);
+	vector<voxel_run_t> &runs(temp_runs);
+	vector<unsigned> &col_runs(temp_col_runs); // index of the first run for each column, plus an end marker
+	runs.clear();
+	col_runs.resize(w*h+1);
+
+	for (unsigned y = y1; y < y2; ++y) {
+		for (unsigned x = x1; x < x2; ++x) {
+			bool const at_edge(keep_at_edge && (x == x1 || x+1 == x2 || y == y1 || y+1 == y2));
+			unsigned const ix0(outside.get_ix(x, y, 0));
+			bool in_run(0);
+			col_runs[(y - y1)*w + (x - x1)] = runs.size();
+
+			for (unsigned z = 0; z < nz; ++z) {
+				unsigned char const val(outside[ix0 + z]);
+				bool const is_anchor(val == UNDER_MESH_BIT || (at_edge && val != 1)); // inside under mesh, or not outside at the range edge
+				if (val != 0 && !is_anchor) {in_run = 0; continue;} // not inside
+				if (in_run) {runs.back().z2 = z+1;} else {runs.emplace_back(z, runs.size()); in_run = 1;}
+				runs.back().anchored |= is_anchor;
+			}
+		}
+	}
+	col_runs[w*h] = runs.size();
+
+	auto find_root = [&runs](unsigned r) {
+		while (runs[r].parent != r) {r = runs[r].parent = runs[runs[r].parent].parent;} // path halving
+		return r;
+	};
+	auto join_columns = [&](unsigned c1, unsigned c2) { // union runs in two adjacent columns that overlap in z
+		for (unsigned i = col_runs[c1], j = col_runs[c2]; i < col_runs[c1+1] && j < col_runs[c2+1];) {
+			if (runs[i].z1 < runs[j].z2 && runs[j].z1 < runs[i].z2) {
+				unsigned a(find_root(i)), b(find_root(j));
+
+				if (a != b) {
+					if (a > b) {std::swap(a, b);}
+					runs[b].parent = a;
+					runs[a].anchored |= runs[b].anchored;
+				}
+			}
+			if (runs[i].z2 < runs[j].z2) {++i;} else {++j;}
+		}
+	};
+	for (unsigned y = 0; y < h; ++y) {
+		for (unsigned x = 0; x < w; ++x) {
+			unsigned const col(y*w + x);
+			if (x > 0) {join_columns(col, col-1);}
+			if (y > 0) {join_columns(col, col-w);}
+		}
+	}
+	// any run not connected to an anchor contains only inside voxels, which are marked outside
+	for (unsigned y = y1; y < y2; ++y) {
+		for (unsigned x = x1; x < x2; ++x) {
+			unsigned const col((y - y1)*w + (x - x1)), ix0(outside.get_ix(x, y, 0));
+			bool had_update(0);
+
+			for (unsigned r = col_runs[col]; r < col_runs[col+1]; ++r) {
+				if (runs[find_root(r)].anchored) continue;
+
+				for (unsigned z = runs[r].z1; z < runs[r].z2; ++z) {
+					unsigned const ix(ix0 + z);
+					assert(outside[ix] == 0);
+					if (updated_pts) {updated_pts->push_back(pt_ix_t(get_pt_at(x, y, z), ix));}
+					if (!mark_only ) {make_voxel_outside(ix);}
+					had_update = 1;
+				}
+			}
+			if (had_update && xy_updated) {xy_updated->push_back(y*nx + x);}
+		}
+	}
+}
+
+
 void voxel_manager::remove_interior_holes() {
 
 	vector<unsigned> &work(temp_work); // stack of voxels to process
@@ -1045,7 +1114,7 @@ void voxel_model_ground::clear() {
 
 
 // returns true if something was cleared
-bool voxel_model::clear_block(unsigned block_ix) {
+bool voxel_model::clear_block(unsigned block_ix, bool for_update) {
 
 	if (tri_data[0].empty()) return 0; // tri_data was already cleared
 	bool was_nonempty(0);
@@ -1059,17 +1128,18 @@ bool voxel_model::clear_block(unsigned block_ix) {
 }
 
 
-bool voxel_model_ground::clear_block(unsigned block_ix) {
+bool voxel_model_ground::clear_block(unsigned block_ix, bool for_update) {
 
-	bool const ret(voxel_model::clear_block(block_ix));
+	bool const ret(voxel_model::clear_block(block_ix, for_update));
 
 	if (add_cobjs) {
 		assert(block_ix < data_blocks.size());
-
-		for (vector<unsigned>::const_iterator i = data_blocks[block_ix].cids.begin(); i != data_blocks[block_ix].cids.end(); ++i) {
-			remove_coll_object(*i);
-		}
-		data_blocks[block_ix].clear();
+		data_block_t &db(data_blocks[block_ix]);
+		for (unsigned cid : db.old_cids) {remove_coll_object(cid);} // in case the block was cleared twice without being recreated
+		db.old_cids.clear();
+		if (for_update) {db.old_cids.swap(db.cids);} // removed or reused in create_block_hook()
+		else {for (unsigned cid : db.cids) {remove_coll_object(cid);}}
+		db.clear();
 	}
 	return ret;
 }
@@ -1135,14 +1205,36 @@ void voxel_model_ground::create_block_hook(unsigned block_ix) { // lod_level ==
 		cparams[d].cobj_type = COBJ_TYPE_VOX_TERRAIN;
 	}
 	assert(block_ix < data_blocks.size());
-	assert(data_blocks[block_ix].cids.empty());
+	data_block_t &db(data_blocks[block_ix]);
+	assert(db.cids.empty());
 	tri_data_t::value_type const &td(tri_data[0][block_ix]);
 	unsigned const num_verts(td.num_verts());
 	assert((num_verts % 3) == 0);
-	data_blocks[block_ix].cids.reserve(num_verts/3);
+	db.cids.reserve(num_verts/3);
+	map<point, vector<unsigned>> old_cobjs; // old cobjs of this block that can be reused, keyed by first point; most are unchanged after a small edit
+
+	for (unsigned cid : db.old_cids) {
+		coll_obj const &c(coll_objects.get_cobj(cid));
+		if (c.status == COLL_STATIC && c.type == COLL_POLYGON) {old_cobjs[c.points[0]].push_back(cid);}
+	}
+	auto reuse_old_cobj = [&](point const *const pts, unsigned npts, cobj_params const &cp) -> int {
+		auto it(old_cobjs.find(pts[0]));
+		if (it == old_cobjs.end()) return -1;
+		vector<unsigned> &cands(it->second);
+
+		for (auto c = cands.begin(); c != cands.end(); ++c) {
+			coll_obj const &cobj(coll_objects.get_cobj(*c));
+			if (cobj.npoints != (int)npts || cobj.cp.tid != cp.tid || cobj.cp.color != cp.color) continue;
+			if (!std::equal(pts, pts+npts, cobj.points)) continue;
+			int const cid(*c);
+			cands.erase(c); // can only be reused once
+			return cid;
+		}
+		return -1;
+	};
 
 	#pragma omp critical(add_coll_polygon)
-	for (unsigned v = 0; v < num_verts; v += 3) {
+	{for (unsigned v = 0; v < num_verts; v += 3) {
 		point const pts[3] = {td.get_vert(v+0).v, td.get_vert(v+1).v, td.get_vert(v+2).v};
 		vector3d const normal(get_poly_norm(pts));
 		if (normal == zero_vector) continue; // degenerate polygon, skip it
@@ -1156,21 +1248,33 @@ void voxel_model_ground::create_block_hook(unsigned block_ix) { // lod_level ==
 			if ((normal - get_poly_norm(pts2)).mag_sq() < 0.0001) {
 				if (pts2[0] == pts[1] && pts2[2] == pts[2]) { // merge two tris into a quad
 					point const quad_pts[4] = {pts[0], pts[1], pts2[1], pts[2]};
-					cindex = add_simple_coll_polygon(quad_pts, 4, cparams[cp_ix], normal);
+					cindex = reuse_old_cobj(quad_pts, 4, cparams[cp_ix]);
+					if (cindex < 0) {cindex = add_simple_coll_polygon(quad_pts, 4, cparams[cp_ix], normal);}
 					v += 3; // skip the second triangle
 				}
 				else if (pts2[1] == pts[1] && pts2[0] == pts[2]) { // merge two tris into a quad
 					point const quad_pts[4] = {pts[0], pts[1], pts2[2], pts[2]};
-					cindex = add_simple_coll_polygon(quad_pts, 4, cparams[cp_ix], normal);
+					cindex = reuse_old_cobj(quad_pts, 4, cparams[cp_ix]);
+					if (cindex < 0) {cindex = add_simple_coll_polygon(quad_pts, 4, cparams[cp_ix], normal);}
 					v += 3; // skip the second triangle
 				}
 			}
 		}
 #endif
+		if (cindex < 0) {cindex = reuse_old_cobj(pts, 3, cparams[cp_ix]);}
 		if (cindex < 0) {cindex = add_simple_coll_polygon(pts, 3, cparams[cp_ix], normal);}
 		if (add_as_fixed) {coll_objects.get_cobj(cindex).fixed = 1;} // mark as fixed so that lmap cells will be generated and cobjs will be re-added
-		data_blocks[block_ix].cids.push_back(cindex);
+		db.cids.push_back(cindex);
+	} // for v
+	for (auto const &cands : old_cobjs) { // remove old cobjs that weren't reused
+		for (unsigned cid : cands.second) {remove_coll_object(cid);}
+	}
+	for (unsigned cid : db.old_cids) { // remove old cobjs that weren't candidates for reuse (already freed, etc.)
+		coll_obj const &c(coll_objects.get_cobj(cid));
+		if (!(c.status == COLL_STATIC && c.type == COLL_POLYGON)) {remove_coll_object(cid);}
 	}
+	} // end critical section
+	db.old_cids.clear();
 	// Note: this call is really only safe to do without trying to the add_coll_polygon critical section because
 	// coll_objects has been reserved ahead of time and won't be resized (meaning the pointers are always valid)
 	cobj_tree.add_cobjs_for_block(data_blocks[block_ix].cids, block_ix%params.num_blocks, block_ix/params.num_blocks);
@@ -1397,9 +1501,8 @@ void voxel_model::proc_pending_updates(bool postproc_brushes_mode) {
 	vector<unsigned> blocks_to_update(modified_blocks.begin(), modified_blocks.end());
 	
 	// TODO: can we only remove/add voxels within the modified region of each block?
-	//       or, create the block first and only remove triangles that don't exist in the new block + add triangles that don't exist in the old block?
-	for (auto i = blocks_to_update.begin(); i != blocks_to_update.end(); ++i) {something_removed |= clear_block(*i);}
-	if (something_removed) {purge_coll_freed(0);} // unecessary?
+	// Note: cobjs of unchanged polygons are reused when the block is recreated rather than being removed and added again
+	for (auto i = blocks_to_update.begin(); i != blocks_to_update.end(); ++i) {something_removed |= clear_block(*i, 1);} // for_update=1
 	vector<unsigned> num_added(blocks_to_update.size(), 0);
 	unsigned tot_num_added(0);
 
@@ -1408,14 +1511,11 @@ void voxel_model::proc_pending_updates(bool postproc_brushes_mode) {
 		num_added[i] = (create_block_all_lods(blocks_to_update[i], 0, 0) > 0);
 	}
 	for (auto i = num_added.begin(); i != num_added.end(); ++i) {tot_num_added += *i;}
+	if (something_removed) {purge_coll_freed(0);} // unecessary? after create, since unused cobjs are removed there
 
 	// Note: this part only needs to be done once per block at the end of the while loop, but in practice is fast anyway
 	if (tot_num_added > 0 || something_removed) { // something was added or removed
-		if (!boundary_vnmap[0].empty()) { // fix block boundary vertex normals
-			for (unsigned i = 0; i < blocks_to_update.size(); ++i) {
-				update_boundary_normals_for_block(blocks_to_update[i], 0);
-			}
-		}
+		if (!boundary_vnmap[0].empty()) {update_boundary_normals_for_blocks(blocks_to_update, 0);} // fix block boundary vertex normals
 		for (unsigned i = 0; i < blocks_to_update.size(); ++i) { // blocks will be sorted by y then x
 			calc_ao_lighting_for_block(blocks_to_update[i], !volume_added); // update can only remove, so lighting can only increase
 		}
@@ -1476,20 +1576,25 @@ void voxel_model::merge_vn_t::finalize() {
 }
 
 
-void voxel_model::update_boundary_normals_for_block(unsigned block_ix, bool calc_average) {
+void voxel_model::update_boundary_normals_for_block(unsigned block_ix, unsigned lod, bool calc_average) {
 
+	if (!tri_data[lod][block_ix].indexing_enabled()) return;
 	unsigned const xbix(block_ix%params.num_blocks), ybix(block_ix/params.num_blocks);
 	cube_t const bbox(get_xv(xbix*xblocks), get_xv(min(nx-1, (xbix+1)*xblocks)), get_yv(ybix*yblocks), get_yv(min(ny-1, (ybix+1)*yblocks)), 0.0, 0.0);
 
-	for (unsigned lod = 0; lod < tri_data.size(); ++lod) {
-		if (!tri_data[lod][block_ix].indexing_enabled()) continue;
+	for (tri_data_t::value_type::iterator i = tri_data[lod][block_ix].begin(); i != tri_data[lod][block_ix].end(); ++i) {
+		if (i->v.x != bbox.d[0][0] && i->v.x != bbox.d[0][1] && i->v.y != bbox.d[1][0] && i->v.y != bbox.d[1][1]) continue; // not at a block boundary
+		// Note: should be no duplicates within the same block
+		merge_vn_t &vn(boundary_vnmap[lod][i->v]);
+		if (calc_average) {vn.add(*i);} else {vn.update(*i);}
+	}
+}
 
-		for (tri_data_t::value_type::iterator i = tri_data[lod][block_ix].begin(); i != tri_data[lod][block_ix].end(); ++i) {
-			if (i->v.x != bbox.d[0][0] && i->v.x != bbox.d[0][1] && i->v.y != bbox.d[1][0] && i->v.y != bbox.d[1][1]) continue; // not at a block boundary
-			// Note: should be no duplicates within the same block
-			merge_vn_t &vn(boundary_vnmap[lod][i->v]);
-			if (calc_average) {vn.add(*i);} else {vn.update(*i);}
-		}
+void voxel_model::update_boundary_normals_for_blocks(vector<unsigned> const &blocks, bool calc_average) {
+	// each LOD has its own triangles and boundary map, so LODs can be processed in parallel; blocks must be processed in order within a LOD
+#pragma omp parallel for schedule(dynamic,1)
+	for (int lod = 0; lod < (int)tri_data.size(); ++lod) {
+		for (unsigned block_ix : blocks) {update_boundary_normals_for_block(block_ix, lod, calc_average);}
 	}
 }
 
@@ -1554,9 +1659,9 @@ void voxel_model::build(bool verbose, bool do_ao_lighting) {
 	if (verbose) {PRINT_TIME("  Triangles to Model");}
 
 	if (tot_blocks > 1) { // merge triangle vertices along block seams
-		for (unsigned block_ix = 0; block_ix < tot_blocks; ++block_ix) {
-			update_boundary_normals_for_block(block_ix, 1);
-		}
+		vector<unsigned> all_blocks(tot_blocks);
+		for (unsigned block_ix = 0; block_ix < tot_blocks; ++block_ix) {all_blocks[block_ix] = block_ix;}
+		update_boundary_normals_for_blocks(all_blocks, 1);
 		finalize_boundary_vmap();
 		if (verbose) {PRINT_TIME("  Block Seam Merge");}
 	}
@@ -175,6 +175,14 @@ protected:
 	voxel_params_t params;
 	voxel_grid<unsigned char> outside;
 	vector<unsigned> temp_work; // used in remove_unconnected_outside_range()/flood_fill()
+
+	struct voxel_run_t { // vertical run of connected voxels within an x/y column, for union-find
+		unsigned z1, z2, parent; // z range is [z1, z2)
+		bool anchored;
+		voxel_run_t(unsigned z, unsigned parent_) : z1(z), z2(z+1), parent(parent_), anchored(0) {}
+	};
+	vector<voxel_run_t> temp_runs; // used in remove_unconnected_outside_range_mesh()
+	vector<unsigned> temp_col_runs;
 	typedef vert_norm vertex_type_t;
 	typedef vntc_vect_block_t<vertex_type_t> tri_data_t;
 	typedef vertex_map_t<vertex_type_t> vertex_map_type_t;
@@ -197,6 +205,8 @@ protected:
 	void flood_fill_range(unsigned x1, unsigned y1, unsigned x2, unsigned y2, vector<unsigned> &work, unsigned char fill_val, unsigned char bit_mask);
 	void remove_unconnected_outside_range(bool keep_at_edge, unsigned x1, unsigned y1, unsigned x2, unsigned y2,
 		vector<unsigned> *xy_updated, vector<pt_ix_t> *updated_pts, bool mark_only=0);
+	void remove_unconnected_outside_range_mesh(bool keep_at_edge, unsigned x1, unsigned y1, unsigned x2, unsigned y2,
+		vector<unsigned> *xy_updated, vector<pt_ix_t> *updated_pts, bool mark_only);
 	unsigned add_triangles_for_voxel(tri_data_t::value_type &tri_verts, voxel_ix_cache &vix_cache,
 		unsigned x, unsigned y, unsigned z, unsigned block_x0, unsigned block_y0, bool count_only, unsigned lod_level) const;
 	void add_cobj_voxels(coll_obj &cobj, float filled_val);
@@ -282,10 +292,11 @@ protected:
 
 	void remove_unconnected_outside_modified_blocks(bool postproc_brushes_mode);
 	unsigned get_block_ix(unsigned voxel_ix) const;
-	virtual bool clear_block(unsigned block_ix);
+	virtual bool clear_block(unsigned block_ix, bool for_update=0); // for_update: the block will be recreated, so existing cobjs may be reused
 	unsigned create_block(voxel_ix_cache &vix_cache, unsigned block_ix, bool first_create, bool count_only, unsigned lod_level);
 	unsigned create_block_all_lods(unsigned block_ix, bool first_create, bool count_only);
-	void update_boundary_normals_for_block(unsigned block_ix, bool calc_average);
+	void update_boundary_normals_for_block(unsigned block_ix, unsigned lod, bool calc_average);
+	void update_boundary_normals_for_blocks(vector<unsigned> const &blocks, bool calc_average);
 	void finalize_boundary_vmap();
 	void calc_ao_dirs();
 	virtual void calc_ao_lighting_for_block(unsigned block_ix, bool increase_only);
@@ -330,12 +341,13 @@ class voxel_model_ground : public voxel_model {
 
 	struct data_block_t {
 		vector<unsigned> cids; // references into coll_objects
+		vector<unsigned> old_cids; // cobjs from before the block was cleared for update; unchanged polygons are reused when the block is recreated
 		//unsigned tri_data_ix;
 		void clear() {cids.clear();}
 	};
 	vector<data_block_t> data_blocks;
 
-	virtual bool clear_block(unsigned block_ix);
+	virtual bool clear_block(unsigned block_ix, bool for_update=0);
 	virtual void maybe_create_fragments(point const &center, float radius, int shooter, unsigned num_fragments, bool directly_from_update) const;
 	virtual void create_block_hook(unsigned block_ix);
 	virtual void update_blocks_hook(vector<unsigned> const &blocks_to_update, unsigned num_added);
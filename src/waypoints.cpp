@@ -10,7 +10,10 @@
 #include "shaders.h"
 #include <queue>
 
+using std::cerr;
 
+
+unsigned const WPT_CACHE_VERSION = 1; // increment when the cache format or waypoint generation changes
 int const WP_RESET_FRAMES      = 100; // Note: in frames, not ticks, fix?
 int const WP_RECENT_FRAMES     = 200;
 float const MAX_FALL_DIST_MULT = 20.0;
@@ -20,6 +23,7 @@ float const STEP_SIZE_MULT2    = 0.50; // reachability tests (relative to smiley
 bool has_user_placed(0), has_item_placed(0), has_wpt_goal(0);
 int show_waypoints(0); // 0=none, 1=waypoints, 2=waypoints+edges
 waypoint_vector waypoints;
+string waypoint_cache_fn; // empty = disabled
 
 extern bool use_waypoints;
 extern int DISABLE_WATER, camera_change, frame_counter, num_smileys, num_groups, display_mode;
@@ -146,6 +150,100 @@ void waypoint_vector::remove(wpt_ix_t ix) {
 }
 
 
+struct wpt_cache_header_t {
+	unsigned version=WPT_CACHE_VERSION, key=0, num_wpts=0, num_free=0;
+};
+
+struct wpt_cache_entry_t { // fixed size part of a waypoint_t; adjacency lists follow
+	point pos;
+	int coll_id=-1, connected_to=-1, item_group=-1, item_ix=-1;
+	unsigned flags=0, num_next=0, num_prev=0;
+};
+
+enum {WPT_FLAG_USER=1, WPT_FLAG_ITEM=2, WPT_FLAG_GOAL=4, WPT_FLAG_TEMP=8, WPT_FLAG_DISABLED=16, WPT_FLAG_NEXT_VALID=32};
+
+bool waypoint_vector::read_cache(string const &fn, unsigned key) {
+
+	FILE *fp(fopen(fn.c_str(), "rb"));
+	if (fp == nullptr) return 0; // not yet written
+	wpt_cache_header_t header;
+	bool valid(fread(&header, sizeof(wpt_cache_header_t), 1, fp) == 1 && header.version == WPT_CACHE_VERSION && header.key == key);
+
+	if (!valid) {
+		cout << "Waypoint cache " << fn << " is invalid or out of date; ignoring it" << endl;
+		checked_fclose(fp);
+		return 0;
+	}
+	waypoint_vector wpts; // read into a temporary so that a failed read leaves this unmodified
+	wpts.resize(header.num_wpts);
+	wpts.free_list.resize(header.num_free);
+	valid = (fread(wpts.free_list.data(), sizeof(wpt_ix_t), header.num_free, fp) == header.num_free);
+
+	for (unsigned i = 0; i < header.num_wpts && valid; ++i) {
+		wpt_cache_entry_t e;
+		valid = (fread(&e, sizeof(wpt_cache_entry_t), 1, fp) == 1 && e.num_next <= header.num_wpts && e.num_prev <= header.num_wpts &&
+			e.coll_id < (int)coll_objects.size() && e.connected_to < (int)header.num_wpts);
+		if (!valid) break;
+		waypoint_t &w(wpts[i]);
+		w = waypoint_t(e.pos, e.coll_id, (e.flags & WPT_FLAG_USER), (e.flags & WPT_FLAG_ITEM), (e.flags & WPT_FLAG_GOAL), (e.flags & WPT_FLAG_TEMP));
+		w.disabled     = ((e.flags & WPT_FLAG_DISABLED  ) != 0);
+		w.next_valid   = ((e.flags & WPT_FLAG_NEXT_VALID) != 0);
+		w.connected_to = e.connected_to;
+		w.item_group   = e.item_group;
+		w.item_ix      = e.item_ix;
+		w.next_wpts.resize(e.num_next);
+		w.prev_wpts.resize(e.num_prev);
+		valid = (fread(w.next_wpts.data(), sizeof(wpt_ix_t), e.num_next, fp) == e.num_next && fread(w.prev_wpts.data(), sizeof(wpt_ix_t), e.num_prev, fp) == e.num_prev);
+		for (auto j = w.next_wpts.begin(); j != w.next_wpts.end() && valid; ++j) {valid = (*j < header.num_wpts);}
+		for (auto j = w.prev_wpts.begin(); j != w.prev_wpts.end() && valid; ++j) {valid = (*j < header.num_wpts);}
+	}
+	checked_fclose(fp);
+
+	if (!valid) {
+		cerr << "Error reading waypoint cache " << fn << endl;
+		return 0;
+	}
+	vector<waypoint_t>::swap(wpts);
+	free_list.swap(wpts.free_list);
+	cout << "Read waypoint cache " << fn << endl;
+	return 1;
+}
+
+void waypoint_vector::write_cache(string const &fn, unsigned key) const {
+
+	FILE *fp(fopen(fn.c_str(), "wb"));
+
+	if (fp == nullptr) {
+		cerr << "Error opening waypoint cache " << fn << " for write" << endl;
+		return;
+	}
+	wpt_cache_header_t header;
+	header.key      = key;
+	header.num_wpts = (unsigned)size();
+	header.num_free = (unsigned)free_list.size();
+	bool valid(fwrite(&header, sizeof(wpt_cache_header_t), 1, fp) == 1);
+	valid &= (fwrite(free_list.data(), sizeof(wpt_ix_t), free_list.size(), fp) == free_list.size());
+
+	for (const_iterator i = begin(); i != end() && valid; ++i) {
+		wpt_cache_entry_t e;
+		e.pos          = i->pos;
+		e.coll_id      = i->coll_id;
+		e.connected_to = i->connected_to;
+		e.item_group   = i->item_group;
+		e.item_ix      = i->item_ix;
+		e.num_next     = (unsigned)i->next_wpts.size();
+		e.num_prev     = (unsigned)i->prev_wpts.size();
+		e.flags        = ((i->user_placed ? WPT_FLAG_USER : 0) | (i->placed_item ? WPT_FLAG_ITEM : 0) | (i->goal ? WPT_FLAG_GOAL : 0) |
+			(i->temp ? WPT_FLAG_TEMP : 0) | (i->disabled ? WPT_FLAG_DISABLED : 0) | (i->next_valid ? WPT_FLAG_NEXT_VALID : 0));
+		valid &= (fwrite(&e, sizeof(wpt_cache_entry_t), 1, fp) == 1);
+		valid &= (fwrite(i->next_wpts.data(), sizeof(wpt_ix_t), e.num_next, fp) == e.num_next);
+		valid &= (fwrite(i->prev_wpts.data(), sizeof(wpt_ix_t), e.num_prev, fp) == e.num_prev);
+	}
+	checked_fclose(fp);
+	if (!valid) {cerr << "Error writing waypoint cache " << fn << endl;}
+}
+
+
 wpt_goal::wpt_goal(int m, unsigned w, point const &p) : mode(m), wpt(w), pos(p) {
 
 	switch (mode) {
@@ -711,6 +809,36 @@ public:
 // ********** waypoint top level code **********
 
 
+// hash of everything that waypoint placement and connectivity depend on
+unsigned get_waypoint_cache_key(vector<user_waypt_t> const &user_waypoints) {
+
+	unsigned hv(coll_objects.get_static_geom_hash());
+
+	for (auto i = coll_objects.begin(); i != coll_objects.end(); ++i) { // waypoints store cobj indices, so static cobj indices must match
+		if (i->status == COLL_STATIC) {hv += (unsigned)(i - coll_objects.begin()); hv += hv << 10; hv ^= hv >> 6;}
+	}
+	hash_mix_point(point(use_waypoints, (display_mode & 0x01), DISABLE_WATER), hv);
+	hash_mix_point(point(object_types[WAYPOINT].radius, waypoint_sz_thresh, CAMERA_RADIUS), hv);
+	hash_mix_point(point((temperature <= W_FREEZE_POINT), water_plane_z, zmin), hv);
+	hash_mix_point(point(X_SCENE_SIZE, Y_SCENE_SIZE, Z_SCENE_SIZE), hv);
+	hash_mix_point(point(get_xval(0), get_yval(0), DX_VAL), hv);
+
+	for (int y = 0; y < MESH_Y_SIZE; ++y) {
+		for (int x = 0; x < MESH_X_SIZE; ++x) {hash_mix_point(point(mesh_height[y][x], water_matrix[y][x], (is_mesh_disabled(x, y) ? 2 : has_water(x, y))), hv);}
+	}
+	for (auto i = user_waypoints.begin(); i != user_waypoints.end(); ++i) {hash_mix_point(i->pos, hv); hv += i->type;}
+
+	for (int i = 0; i < num_groups; ++i) {
+		vector<predef_obj> const &objs(obj_groups[i].get_predef_objs());
+		for (auto j = objs.begin(); j != objs.end(); ++j) {hash_mix_point(j->pos, hv);}
+		hv += (unsigned)objs.size();
+	}
+	for (auto i = teleporters[0].begin(); i != teleporters[0].end(); ++i) {hash_mix_point(i->pos, hv); hash_mix_point(i->dest, hv);}
+	for (auto i = jump_pads.begin(); i != jump_pads.end(); ++i) {hash_mix_point(i->pos, hv);}
+	return hv;
+}
+
+
 void create_waypoints(vector<user_waypt_t> const &user_waypoints) {
 
 	RESET_TIME;
@@ -724,6 +852,19 @@ void create_waypoints(vector<user_waypt_t> const &user_waypoints) {
 		waypoints.push_back(waypoint_t(i->pos, -1, 1, 0, (i->type == 1))); // goal is type 1
 		if (waypoints.back().goal) has_wpt_goal = 1;
 	}
+	unsigned const cache_key(waypoint_cache_fn.empty() ? 0 : get_waypoint_cache_key(user_waypoints));
+
+	if (!waypoint_cache_fn.empty() && waypoints.read_cache(waypoint_cache_fn, cache_key)) {
+		// restore state that the builder would have set on cobjs and globals
+		for (unsigned i = 0; i < waypoints.size(); ++i) {
+			waypoint_t const &w(waypoints[i]);
+			if (w.disabled) continue;
+			has_item_placed |= w.placed_item;
+			if (w.coll_id >= 0) {coll_objects.get_cobj(w.coll_id).waypt_id = i;} // the last waypoint for this cobj
+		}
+		PRINT_TIME("  Waypoint Cache Load");
+		return;
+	}
 	waypoint_builder wb;
 
 	if (use_waypoints) {
@@ -734,6 +875,7 @@ void create_waypoints(vector<user_waypt_t> const &user_waypoints) {
 	}
 	wb.connect_all_waypoints();
 	PRINT_TIME("  Waypoint Connectivity");
+	if (!waypoint_cache_fn.empty()) {waypoints.write_cache(waypoint_cache_fn, cache_key);}
 }
 
 